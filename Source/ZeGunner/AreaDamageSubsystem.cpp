@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AreaDamageSubsystem.h"
+#include "EnemySpatialGridSubsystem.h"
+#include "EnemyMovementSubsystem.h"
+#include "EnemyRegistrySubsystem.h"
+#include "EnemyKillSubsystem.h"
+#include "ZeGunner.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Area Damage Flush"), STAT_AreaDamageFlush, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Area Damage Blasts"), STAT_AreaDamageBlasts, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Area Damage Kill Requests"), STAT_AreaDamageKillRequests, STATGROUP_ZeGunner);
+
+void UAreaDamageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Collection.InitializeDependency<UEnemySpatialGridSubsystem>();
+	Collection.InitializeDependency<UEnemyMovementSubsystem>();
+	Collection.InitializeDependency<UEnemyRegistrySubsystem>();
+	Collection.InitializeDependency<UEnemyKillSubsystem>();
+}
+
+bool UAreaDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAreaDamageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAreaDamageSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Requests ====================
+
+void UAreaDamageSubsystem::ApplyRadialDamage(const FVector& Center, float Radius, AActor* Instigator, AActor* DirectHit, uint8 TypeMask)
+{
+	FAreaDamageRequest& Request = Requests.AddDefaulted_GetRef();
+	Request.Center = Center;
+	Request.Radius = FMath::Max(0.0f, Radius);
+	Request.TypeMask = TypeMask;
+	Request.Instigator = Instigator;
+	Request.DirectHit = DirectHit;
+}
+
+void UAreaDamageSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Flush();
+}
+
+// ==================== Damage Pass ====================
+
+void UAreaDamageSubsystem::Flush()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AreaDamageFlush);
+
+	UWorld* World = GetWorld();
+	const UEnemySpatialGridSubsystem* SpatialGrid = World->GetSubsystem<UEnemySpatialGridSubsystem>();
+	const UEnemyMovementSubsystem* Movement = World->GetSubsystem<UEnemyMovementSubsystem>();
+	const UEnemyRegistrySubsystem* Registry = World->GetSubsystem<UEnemyRegistrySubsystem>();
+	UEnemyKillSubsystem* Kills = World->GetSubsystem<UEnemyKillSubsystem>();
+	if (!Kills || !Registry)
+	{
+		Requests.Reset();
+		return;
+	}
+
+	// Taken up front; kills resolve later, so overlapping blasts all see the same enemies
+	Swap(Requests, FlushingRequests);
+	Requests.Reset();
+
+	int32 NumKillRequests = 0;
+	for (const FAreaDamageRequest& Blast : FlushingRequests)
+	{
+		const AActor* Instigator = Blast.Instigator.Get();
+
+		EEnemyType DirectHitType;
+		APawn* DirectHit = Cast<APawn>(Blast.DirectHit.Get());
+		if (DirectHit && DirectHit != Instigator && Registry->FindEnemyType(DirectHit, DirectHitType)
+			&& (Blast.TypeMask & EnemyTypeBit(DirectHitType)))
+		{
+			Kills->RequestKill(DirectHit);
+			++NumKillRequests;
+		}
+
+		if (Blast.Radius <= 0.0f || !SpatialGrid || !Movement)
+		{
+			continue;
+		}
+
+		CandidateHandles.Reset();
+		SpatialGrid->QueryRadius(Blast.Center, Blast.Radius, CandidateHandles, Blast.TypeMask);
+		for (const FEnemyHandle& Handle : CandidateHandles)
+		{
+			APawn* Enemy = Movement->GetActor(Handle);
+			if (Enemy && Enemy != Instigator)
+			{
+				Kills->RequestKill(Enemy);
+				++NumKillRequests;
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_AreaDamageBlasts, FlushingRequests.Num());
+	SET_DWORD_STAT(STAT_AreaDamageKillRequests, NumKillRequests);
+}
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyTypes.h"
+#include "AreaDamageSubsystem.generated.h"
+
+/** One blast waiting for the end-of-frame damage pass */
+struct FAreaDamageRequest
+{
+	FVector Center = FVector::ZeroVector;
+	float Radius = 0.0f;
+	uint8 TypeMask = AllEnemyTypesMask;
+	TWeakObjectPtr<AActor> Instigator;
+
+	/** Actor the projectile struck, killed even when its center is outside Radius */
+	TWeakObjectPtr<AActor> DirectHit;
+};
+
+/**
+ * Splash damage for every projectile. Blasts are queued during the frame and resolved
+ * together in one pass: each blast gathers enemies from UEnemySpatialGridSubsystem (no physics
+ * overlaps) and asks UEnemyKillSubsystem to kill it; the kill queue makes sure an enemy
+ * caught by several blasts in the same frame only dies once.
+ */
+UCLASS()
+class ZEGUNNER_API UAreaDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Requests.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Queue a blast for this frame's damage pass.
+	 * @param Radius - Enemies whose center is within this distance die (0 = direct hit only)
+	 * @param Instigator - Never damaged by its own blast
+	 * @param DirectHit - Actor the projectile struck; killed if it is an enemy matching TypeMask
+	 * @param TypeMask - Enemy types the blast can hurt (EnemyTypeBit)
+	 */
+	void ApplyRadialDamage(const FVector& Center, float Radius, AActor* Instigator, AActor* DirectHit = nullptr, uint8 TypeMask = AllEnemyTypesMask);
+
+	/** Resolve every queued blast now */
+	void Flush();
+
+private:
+	TArray<FAreaDamageRequest> Requests;
+
+	/** Requests being flushed; swapped with Requests so neither array reallocates per frame */
+	TArray<FAreaDamageRequest> FlushingRequests;
+
+	/** Scratch buffer reused by every flush */
+	TArray<FEnemyHandle> CandidateHandles;
+};
@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BaseDamageSubsystem.h"
+#include "ZeGunner.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Base Hits"), STAT_BaseHits, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Base Damage"), STAT_BaseDamage, STATGROUP_ZeGunner);
+
+void UBaseDamageSubsystem::QueueDamage(EEnemyType Source, int32 Damage)
+{
+	Pending.TotalDamage += Damage;
+	Pending.DamageByType[static_cast<int32>(Source)] += Damage;
+	++Pending.NumHits;
+}
+
+void UBaseDamageSubsystem::QueueDamage(int32 Damage)
+{
+	Pending.TotalDamage += Damage;
+	Pending.UnattributedDamage += Damage;
+	++Pending.NumHits;
+}
+
+FBaseDamageFrame UBaseDamageSubsystem::Drain()
+{
+	FBaseDamageFrame Frame = Pending;
+	Pending = FBaseDamageFrame();
+
+	SET_DWORD_STAT(STAT_BaseHits, Frame.NumHits);
+	SET_DWORD_STAT(STAT_BaseDamage, Frame.TotalDamage);
+	return Frame;
+}
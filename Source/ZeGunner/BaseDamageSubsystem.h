@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyTypes.h"
+#include "BaseDamageSubsystem.generated.h"
+
+/** Damage dealt to the base during one frame, summed per source */
+struct FBaseDamageFrame
+{
+	/** Total damage from all sources */
+	int32 TotalDamage = 0;
+
+	/** Number of hits queued */
+	int32 NumHits = 0;
+
+	/** Damage per enemy type (indexed by EEnemyType) */
+	int32 DamageByType[NumEnemyTypes] = {};
+
+	/** Damage queued without a known source (e.g. from Blueprint) */
+	int32 UnattributedDamage = 0;
+
+	bool HasDamage() const { return NumHits > 0; }
+};
+
+/**
+ * Frame-local queue of hits on the base.
+ * Enemies append shots as they fire; AFighterPawn drains the queue once per frame
+ * and applies the summed damage in one go.
+ */
+UCLASS()
+class ZEGUNNER_API UBaseDamageSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Queue damage from an enemy of the given type */
+	void QueueDamage(EEnemyType Source, int32 Damage = 1);
+
+	/** Queue damage with no attributed source */
+	void QueueDamage(int32 Damage);
+
+	/** Hand over everything queued since the last drain and reset the queue */
+	FBaseDamageFrame Drain();
+
+private:
+	FBaseDamageFrame Pending;
+};
@@ -1,28 +1,28 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BombProjectile.h"
-#include "TankAI.h"
-#include "HeliAI.h"
+#include "AreaDamageSubsystem.h"
+#include "ProjectileSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
 
 ABombProjectile::ABombProjectile()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bCanEverTick = true;
 
-	// Create collision sphere as root
+	// Collision sphere as root; it only sizes the sweep, the arc is computed rather than simulated
 	CollisionComponent = CreateDefaultSubobject<USphereComponent>(TEXT("CollisionComponent"));
 	CollisionComponent->InitSphereRadius(50.0f);
-	CollisionComponent->SetCollisionProfileName(TEXT("BlockAllDynamic"));
-	CollisionComponent->SetSimulatePhysics(true);
-	CollisionComponent->SetEnableGravity(true);
-	CollisionComponent->SetNotifyRigidBodyCollision(true);
+	CollisionComponent->SetCollisionProfileName(TEXT("Projectile"));
+	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	CollisionComponent->SetGenerateOverlapEvents(false);
+	CollisionComponent->SetSimulatePhysics(false);
+	CollisionComponent->SetEnableGravity(false);
 	RootComponent = CollisionComponent;
 
-	// Create static mesh - NOT attached to physics component
 	BombMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("BombMesh"));
-	BombMesh->SetupAttachment(RootComponent); // Attach to root, not collision
+	BombMesh->SetupAttachment(RootComponent);
 	BombMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
@@ -31,121 +31,120 @@ void ABombProjectile::BeginPlay()
 	Super::BeginPlay();
 
 	SetLifeSpan(LifeSpan);
-	CollisionComponent->OnComponentHit.AddDynamic(this, &ABombProjectile::OnBombHit);
+	Gravity = FVector(0.0f, 0.0f, GetWorld()->GetGravityZ());
 
-	if (BombMesh)
+	// Dropped bombs keep the bomber's momentum unless the spawner sets it explicitly
+	SetInitialVelocity(GetOwner() ? GetOwner()->GetVelocity() : FVector::ZeroVector);
+}
+
+// ==================== Ballistics ====================
+
+void ABombProjectile::SetInitialVelocity(const FVector& InheritedVelocity)
+{
+	LaunchLocation = GetActorLocation();
+	LaunchVelocity = InheritedVelocity + GetActorForwardVector() * BombSpeed;
+	LaunchTime = GetWorld()->GetTimeSeconds();
+	SweptTime = 0.0f;
+
+	PredictImpact();
+}
+
+FVector ABombProjectile::GetPositionAtTime(float Time) const
+{
+	return LaunchLocation + LaunchVelocity * Time + 0.5f * Gravity * FMath::Square(Time);
+}
+
+void ABombProjectile::PredictImpact()
+{
+	FPredictProjectilePathParams Params(CollisionComponent->GetScaledSphereRadius(), LaunchLocation, LaunchVelocity, LifeSpan, ECC_WorldStatic, this);
+	Params.OverrideGravityZ = Gravity.Z;
+	Params.SimFrequency = 15.0f;
+	if (GetOwner())
+	{
+		Params.ActorsToIgnore.Add(GetOwner());
+	}
+
+	FPredictProjectilePathResult Result;
+	bHasPredictedImpact = UGameplayStatics::PredictProjectilePath(this, Params, Result);
+	if (bHasPredictedImpact)
 	{
-		FRotator BeforeRot = BombMesh->GetRelativeRotation();
-		UE_LOG(LogTemp, Log, TEXT("BombProjectile: BeginPlay rotation: %s"), *BeforeRot.ToString());
+		PredictedImpactLocation = Result.HitResult.Location;
+		PredictedImpactTime = Result.LastTraceDestination.Time;
 	}
 }
 
-void ABombProjectile::Tick(float DeltaTime)
+bool ABombProjectile::GetPredictedImpact(FVector& OutLocation, float& OutTimeToImpact) const
 {
-	Super::Tick(DeltaTime);
+	if (!bHasPredictedImpact)
+	{
+		return false;
+	}
+
+	OutLocation = PredictedImpactLocation;
+	OutTimeToImpact = FMath::Max(0.0f, PredictedImpactTime - static_cast<float>(GetWorld()->GetTimeSeconds() - LaunchTime));
+	return true;
 }
 
-void ABombProjectile::OnBombHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void ABombProjectile::Tick(float DeltaTime)
 {
-	// Don't hit the bomber that dropped us
-	if (OtherActor == GetOwner())
+	Super::Tick(DeltaTime);
+
+	const float Time = FMath::Min(static_cast<float>(GetWorld()->GetTimeSeconds() - LaunchTime), LifeSpan);
+	if (Time <= SweptTime)
 	{
 		return;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("BombProjectile: Hit %s at %s"), *OtherActor->GetName(), *GetActorLocation().ToString());
+	const FVector From = GetPositionAtTime(SweptTime);
+	const FVector To = GetPositionAtTime(Time);
+	const float Radius = CollisionComponent->GetScaledSphereRadius();
+	SweptTime = Time;
+
+	// Static geometry along the segment covered this frame
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BombSweep), false, this);
+	QueryParams.AddIgnoredActor(GetOwner());
 
-	// Splash damage: find all actors within ExplosionRadius
-	FVector BombLocation = GetActorLocation();
+	FHitResult TerrainHit;
+	const bool bHitTerrain = GetWorld()->SweepSingleByChannel(TerrainHit, From, To, FQuat::Identity, ECC_WorldStatic, FCollisionShape::MakeSphere(Radius), QueryParams);
+	const float TerrainFraction = bHitTerrain ? TerrainHit.Time : 1.0f;
 
-	if (ExplosionRadius > 0.0f)
+	// Bombs only hurt ground and low air targets: tanks and helicopters
+	APawn* HitEnemy = nullptr;
+	float EnemyFraction = 1.0f;
+	if (UProjectileSubsystem* Projectiles = GetWorld()->GetSubsystem<UProjectileSubsystem>())
 	{
-		// Use sphere trace to find all actors in blast radius
-		TArray<FHitResult> HitResults;
-		FCollisionShape Sphere = FCollisionShape::MakeSphere(ExplosionRadius);
-		bool bHasHits = GetWorld()->SweepMultiByChannel(
-			HitResults,
-			BombLocation,
-			BombLocation,
-			FQuat::Identity,
-			ECC_WorldDynamic,
-			Sphere
-		);
-
-		if (bHasHits)
-		{
-			for (const FHitResult& SplashHit : HitResults)
-			{
-				AActor* HitActor = SplashHit.GetActor();
-				if (!HitActor || HitActor == this || HitActor == GetOwner())
-				{
-					continue;
-				}
-
-				if (ATankAI* Tank = Cast<ATankAI>(HitActor))
-				{
-					float Dist = FVector::Dist(BombLocation, Tank->GetActorLocation());
-					UE_LOG(LogTemp, Log, TEXT("BombProjectile: Splash hit tank at distance %.0f (radius %.0f)"), Dist, ExplosionRadius);
-					Tank->Destroy();
-				}
-				else if (AHeliAI* Heli = Cast<AHeliAI>(HitActor))
-				{
-					float Dist = FVector::Dist(BombLocation, Heli->GetActorLocation());
-					UE_LOG(LogTemp, Log, TEXT("BombProjectile: Splash hit heli at distance %.0f (radius %.0f)"), Dist, ExplosionRadius);
-					Heli->Destroy();
-				}
-			}
-		}
-		else
-		{
-			UE_LOG(LogTemp, Log, TEXT("BombProjectile: No splash hits found within radius %.0f"), ExplosionRadius);
-		}
+		EnemyFraction = Projectiles->SweepEnemies(From, To, Radius, HitEnemy,
+			EnemyTypeBit(EEnemyType::Tank) | EnemyTypeBit(EEnemyType::Heli));
 	}
 
-	// Also check direct hit (in case overlap missed due to collision channel)
-	if (ATankAI* Tank = Cast<ATankAI>(OtherActor))
+	if (HitEnemy && EnemyFraction <= TerrainFraction)
 	{
-		if (!Tank->IsActorBeingDestroyed())
-		{
-			UE_LOG(LogTemp, Log, TEXT("BombProjectile: Direct hit on tank!"));
-			Tank->Destroy();
-		}
+		Detonate(FMath::Lerp(From, To, EnemyFraction), HitEnemy);
+		return;
 	}
-	else if (AHeliAI* Heli = Cast<AHeliAI>(OtherActor))
+	if (bHitTerrain)
 	{
-		if (!Heli->IsActorBeingDestroyed())
-		{
-			UE_LOG(LogTemp, Log, TEXT("BombProjectile: Direct hit on helicopter!"));
-			Heli->Destroy();
-		}
+		Detonate(TerrainHit.Location, nullptr);
+		return;
 	}
 
-	// Destroy the bomb
-	Destroy();
+	const FVector Velocity = LaunchVelocity + Gravity * Time;
+	SetActorLocationAndRotation(To, Velocity.Rotation());
 }
 
-void ABombProjectile::OnBombOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+// ==================== Detonation ====================
+
+void ABombProjectile::Detonate(const FVector& BombLocation, APawn* DirectHit)
 {
-	// Don't hit the bomber that dropped us
-	if (OtherActor == GetOwner())
-	{
-		return;
-	}
+	UE_LOG(LogTemp, Log, TEXT("BombProjectile: Impact at %s after %.2fs"), *BombLocation.ToString(), SweptTime);
 
-	// Check if we hit a tank
-	if (ATankAI* Tank = Cast<ATankAI>(OtherActor))
+	// Bombs only hurt ground and low air targets: tanks and helicopters
+	if (UAreaDamageSubsystem* AreaDamage = GetWorld()->GetSubsystem<UAreaDamageSubsystem>())
 	{
-		UE_LOG(LogTemp, Log, TEXT("BombProjectile: Overlap hit on tank!"));
-		Tank->Destroy();
-		Destroy();
+		AreaDamage->ApplyRadialDamage(BombLocation, ExplosionRadius, GetOwner(), DirectHit,
+			EnemyTypeBit(EEnemyType::Tank) | EnemyTypeBit(EEnemyType::Heli));
 	}
 
-	// Check if we hit a helicopter
-	if (AHeliAI* Heli = Cast<AHeliAI>(OtherActor))
-	{
-		UE_LOG(LogTemp, Log, TEXT("BombProjectile: Overlap hit on helicopter!"));
-		Heli->Destroy();
-		Destroy();
-	}
+	// Destroy the bomb
+	Destroy();
 }
-
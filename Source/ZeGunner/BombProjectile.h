@@ -6,6 +6,12 @@
 #include "GameFramework/Actor.h"
 #include "BombProjectile.generated.h"
 
+/**
+ * Free-falling bomb on a closed-form ballistic arc. Position is a pure function of the launch
+ * state and elapsed time (P0 + V0*t + g*t^2/2), so there is no rigid body to integrate. Each
+ * frame the segment covered since the last one is swept against static geometry and enemy
+ * bounds; the first hit detonates the bomb. The impact point is predicted at launch for HUD use.
+ */
 UCLASS()
 class ZEGUNNER_API ABombProjectile : public AActor
 {
@@ -14,11 +20,24 @@ class ZEGUNNER_API ABombProjectile : public AActor
 public:
 	ABombProjectile();
 
+	/**
+	 * Restart the arc from the current location with this velocity (e.g. the bomber's velocity).
+	 * BombSpeed is added along the bomb's forward vector; the impact point is predicted again.
+	 */
+	void SetInitialVelocity(const FVector& InheritedVelocity);
+
+	/** Where the arc meets static geometry, if it does within the lifespan */
+	UFUNCTION(BlueprintPure, Category = "Bomb")
+	bool GetPredictedImpact(FVector& OutLocation, float& OutTimeToImpact) const;
+
+	/** Bomb position at a time since launch (ignores collision) */
+	FVector GetPositionAtTime(float Time) const;
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
 
-	/** Collision sphere for hit detection */
+	/** Collision sphere, sized to the bomb; also the radius of the per-frame sweep */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Bomb")
 	class USphereComponent* CollisionComponent;
 
@@ -42,14 +61,24 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bomb")
 	FRotator MeshRotationOffset = FRotator(0.0f, 0.0f, 0.0f);
 
-
 private:
-	/** Called when the bomb hits something */
-	UFUNCTION()
-	void OnBombHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+	// ==================== Launch State ====================
+
+	FVector LaunchLocation = FVector::ZeroVector;
+	FVector LaunchVelocity = FVector::ZeroVector;
+	FVector Gravity = FVector::ZeroVector;
+	double LaunchTime = 0.0;
+
+	/** Time since launch already swept for hits */
+	float SweptTime = 0.0f;
+
+	bool bHasPredictedImpact = false;
+	FVector PredictedImpactLocation = FVector::ZeroVector;
+	float PredictedImpactTime = 0.0f;
 
-	/** Called when the bomb overlaps something */
-	UFUNCTION()
-	void OnBombOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	/** Trace the arc against static geometry and cache where it lands */
+	void PredictImpact();
 
+	/** Splash the enemies around BombLocation, destroy DirectHit and remove the bomb */
+	void Detonate(const FVector& BombLocation, APawn* DirectHit);
 };
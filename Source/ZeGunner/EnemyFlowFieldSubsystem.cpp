@@ -0,0 +1,298 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EnemyFlowFieldSubsystem.h"
+#include "ZeGunner.h"
+#include "Engine/World.h"
+#include "LandscapeProxy.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flow Field Bake"), STAT_FlowFieldBake, STATGROUP_ZeGunner);
+
+namespace
+{
+	/** Half height of the vertical obstacle trace through each cell */
+	constexpr float ObstacleTraceHalfHeight = 50000.0f;
+
+	/** Steps whose headings differ less than this are merged into one route segment */
+	constexpr float CollinearDot = 0.9995f;
+
+	struct FOpenCell
+	{
+		float Cost;
+		int32 Cell;
+	};
+}
+
+bool UEnemyFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyFlowFieldSubsystem::Bake(const FVector& InTarget, float InExtent, float InGoalRadius, float InCellSize, bool bDetectObstacles)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowFieldBake);
+
+	CellSize = FMath::Max(InCellSize, 10.0f);
+	Target = FVector2D(InTarget);
+	GoalRadius = FMath::Max(InGoalRadius, 0.0f);
+	GridSize = FMath::Max(1, FMath::CeilToInt(2.0f * InExtent / CellSize));
+	GridOrigin = Target - FVector2D(GridSize * CellSize * 0.5f);
+
+	const int32 NumCells = GridSize * GridSize;
+	Directions.Init(FVector2f::ZeroVector, NumCells);
+	Blocked.Init(false, NumCells);
+	NumBlocked = 0;
+
+	// Mark cells covered by anything that isn't landscape (the base ring itself is always open)
+	UWorld* World = GetWorld();
+	if (bDetectObstacles && World)
+	{
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FlowFieldBake), false);
+
+		for (int32 Y = 0; Y < GridSize; ++Y)
+		{
+			for (int32 X = 0; X < GridSize; ++X)
+			{
+				const FVector2D Center = GetCellCenter(X, Y);
+				if (FVector2D::Distance(Center, Target) <= GoalRadius)
+				{
+					continue;
+				}
+
+				FHitResult Hit;
+				const FVector Top(Center.X, Center.Y, InTarget.Z + ObstacleTraceHalfHeight);
+				const FVector Bottom(Center.X, Center.Y, InTarget.Z - ObstacleTraceHalfHeight);
+				if (World->LineTraceSingleByChannel(Hit, Top, Bottom, ECC_WorldStatic, QueryParams))
+				{
+					const AActor* HitActor = Hit.GetActor();
+					if (HitActor && !HitActor->IsA<ALandscapeProxy>())
+					{
+						Blocked[Y * GridSize + X] = true;
+						++NumBlocked;
+					}
+				}
+			}
+		}
+	}
+
+	// Integration field: Dijkstra outward from the goal ring
+	TArray<float> Costs;
+	Costs.Init(MAX_flt, NumCells);
+
+	TArray<FOpenCell> Open;
+	auto CheaperFirst = [](const FOpenCell& A, const FOpenCell& B) { return A.Cost < B.Cost; };
+
+	for (int32 Y = 0; Y < GridSize; ++Y)
+	{
+		for (int32 X = 0; X < GridSize; ++X)
+		{
+			const int32 Cell = Y * GridSize + X;
+			if (!Blocked[Cell] && FVector2D::Distance(GetCellCenter(X, Y), Target) <= GoalRadius + CellSize)
+			{
+				Costs[Cell] = 0.0f;
+				Open.HeapPush(FOpenCell{ 0.0f, Cell }, CheaperFirst);
+			}
+		}
+	}
+
+	while (Open.Num() > 0)
+	{
+		FOpenCell Current;
+		Open.HeapPop(Current, CheaperFirst, EAllowShrinking::No);
+		if (Current.Cost > Costs[Current.Cell])
+		{
+			continue;
+		}
+
+		const int32 CX = Current.Cell % GridSize;
+		const int32 CY = Current.Cell / GridSize;
+
+		for (int32 DY = -1; DY <= 1; ++DY)
+		{
+			for (int32 DX = -1; DX <= 1; ++DX)
+			{
+				const int32 NX = CX + DX;
+				const int32 NY = CY + DY;
+				if ((DX == 0 && DY == 0) || NX < 0 || NY < 0 || NX >= GridSize || NY >= GridSize)
+				{
+					continue;
+				}
+
+				const int32 Neighbor = NY * GridSize + NX;
+				if (Blocked[Neighbor])
+				{
+					continue;
+				}
+
+				// No cutting corners past an obstacle
+				const bool bDiagonal = DX != 0 && DY != 0;
+				if (bDiagonal && (Blocked[CY * GridSize + NX] || Blocked[NY * GridSize + CX]))
+				{
+					continue;
+				}
+
+				const float NewCost = Current.Cost + (bDiagonal ? CellSize * UE_SQRT_2 : CellSize);
+				if (NewCost < Costs[Neighbor])
+				{
+					Costs[Neighbor] = NewCost;
+					Open.HeapPush(FOpenCell{ NewCost, Neighbor }, CheaperFirst);
+				}
+			}
+		}
+	}
+
+	// Headings: straight at the base when nothing is in the way, otherwise down the cost gradient
+	for (int32 Y = 0; Y < GridSize; ++Y)
+	{
+		for (int32 X = 0; X < GridSize; ++X)
+		{
+			const int32 Cell = Y * GridSize + X;
+			if (Blocked[Cell] || Costs[Cell] == MAX_flt)
+			{
+				continue;
+			}
+
+			const FVector2D Center = GetCellCenter(X, Y);
+			if (IsPathClear(Center, Target))
+			{
+				Directions[Cell] = FVector2f((Target - Center).GetSafeNormal());
+				continue;
+			}
+
+			int32 BestNeighbor = INDEX_NONE;
+			float BestCost = Costs[Cell];
+			for (int32 DY = -1; DY <= 1; ++DY)
+			{
+				for (int32 DX = -1; DX <= 1; ++DX)
+				{
+					const int32 NX = X + DX;
+					const int32 NY = Y + DY;
+					if (NX < 0 || NY < 0 || NX >= GridSize || NY >= GridSize)
+					{
+						continue;
+					}
+
+					const int32 Neighbor = NY * GridSize + NX;
+					if (Costs[Neighbor] < BestCost)
+					{
+						BestCost = Costs[Neighbor];
+						BestNeighbor = Neighbor;
+					}
+				}
+			}
+
+			if (BestNeighbor != INDEX_NONE)
+			{
+				const FVector2D NeighborCenter = GetCellCenter(BestNeighbor % GridSize, BestNeighbor / GridSize);
+				Directions[Cell] = FVector2f((NeighborCenter - Center).GetSafeNormal());
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("EnemyFlowField: Baked %dx%d cells of %.0f units, %d blocked"), GridSize, GridSize, CellSize, NumBlocked);
+}
+
+bool UEnemyFlowFieldSubsystem::GetDirection(const FVector2D& Location, FVector2D& OutDirection) const
+{
+	const int32 Cell = ToCellIndex(Location);
+	if (Cell == INDEX_NONE || Blocked[Cell] || Directions[Cell].IsZero())
+	{
+		return false;
+	}
+
+	OutDirection = FVector2D(Directions[Cell]);
+	return true;
+}
+
+bool UEnemyFlowFieldSubsystem::IsPathClear(const FVector2D& From, const FVector2D& To) const
+{
+	// Open terrain keeps every query flat
+	if (NumBlocked == 0)
+	{
+		return true;
+	}
+
+	const float Distance = static_cast<float>(FVector2D::Distance(From, To));
+	const int32 Steps = FMath::Max(1, FMath::CeilToInt(Distance / (CellSize * 0.5f)));
+	for (int32 Step = 0; Step <= Steps; ++Step)
+	{
+		const int32 Cell = ToCellIndex(FMath::Lerp(From, To, static_cast<double>(Step) / Steps));
+		if (Cell != INDEX_NONE && Blocked[Cell])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void UEnemyFlowFieldSubsystem::TraceRoute(const FVector2D& Start, float StopRadius, TArray<FVector2D>& OutPoints) const
+{
+	const float StepLength = CellSize * 0.5f;
+	const int32 MaxSteps = GridSize * 4;
+
+	FVector2D Point = Start;
+	FVector2D LastDirection = FVector2D::ZeroVector;
+	bool bStartedSegment = false;
+
+	for (int32 Step = 0; Step < MaxSteps; ++Step)
+	{
+		const FVector2D ToTarget = Target - Point;
+		const float Distance = static_cast<float>(ToTarget.Size());
+		if (Distance <= StopRadius + KINDA_SMALL_NUMBER)
+		{
+			return;
+		}
+
+		// Finish with a straight run once the ring is in clear view
+		if (IsPathClear(Point, Target))
+		{
+			break;
+		}
+
+		FVector2D Direction;
+		if (!GetDirection(Point, Direction))
+		{
+			Direction = ToTarget / Distance;
+		}
+
+		Point += Direction * StepLength;
+
+		if (bStartedSegment && FVector2D::DotProduct(Direction, LastDirection) > CollinearDot)
+		{
+			OutPoints.Last() = Point;
+		}
+		else
+		{
+			OutPoints.Add(Point);
+			bStartedSegment = true;
+		}
+		LastDirection = Direction;
+	}
+
+	const FVector2D ToTarget = Target - Point;
+	const float Distance = static_cast<float>(ToTarget.Size());
+	if (Distance > StopRadius)
+	{
+		OutPoints.Add(Point + ToTarget / Distance * (Distance - StopRadius));
+	}
+}
+
+int32 UEnemyFlowFieldSubsystem::ToCellIndex(const FVector2D& Location) const
+{
+	if (GridSize <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 X = FMath::FloorToInt32((Location.X - GridOrigin.X) / CellSize);
+	const int32 Y = FMath::FloorToInt32((Location.Y - GridOrigin.Y) / CellSize);
+	if (X < 0 || Y < 0 || X >= GridSize || Y >= GridSize)
+	{
+		return INDEX_NONE;
+	}
+	return Y * GridSize + X;
+}
+
+FVector2D UEnemyFlowFieldSubsystem::GetCellCenter(int32 X, int32 Y) const
+{
+	return GridOrigin + FVector2D((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize);
+}
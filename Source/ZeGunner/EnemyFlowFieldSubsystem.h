@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyFlowFieldSubsystem.generated.h"
+
+/**
+ * Direction grid around the base shared by all tanks, baked once per level.
+ * Every cell stores the heading that leads to the line-of-fire ring, routing around
+ * non-landscape static geometry when obstacle detection is enabled.
+ * Reads are const and safe from the parallel enemy movement step.
+ */
+UCLASS()
+class ZEGUNNER_API UEnemyFlowFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Bake the field (game thread only).
+	 * @param InTarget - Base location the field flows toward
+	 * @param InExtent - Half size of the square grid around the target
+	 * @param InGoalRadius - Radius of the ring around the target that counts as arrived (line of fire)
+	 * @param InCellSize - Grid resolution in units
+	 * @param bDetectObstacles - Trace each cell and route around anything that isn't landscape
+	 */
+	void Bake(const FVector& InTarget, float InExtent, float InGoalRadius, float InCellSize, bool bDetectObstacles);
+
+	/** Has a field been baked for this level? */
+	bool IsBaked() const { return GridSize > 0; }
+
+	/** Base location the field was baked toward */
+	FVector2D GetTarget() const { return Target; }
+
+	/** Heading at a location (single cell lookup). False outside the grid or in a blocked cell. */
+	bool GetDirection(const FVector2D& Location, FVector2D& OutDirection) const;
+
+	/** Whether a straight line crosses no blocked cell */
+	bool IsPathClear(const FVector2D& From, const FVector2D& To) const;
+
+	/**
+	 * Follow the field from Start until within StopRadius of the target.
+	 * Appends the corners of the route (collinear steps merged), ending on the ring.
+	 */
+	void TraceRoute(const FVector2D& Start, float StopRadius, TArray<FVector2D>& OutPoints) const;
+
+private:
+	/** Bottom-left corner of the grid */
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+
+	FVector2D Target = FVector2D::ZeroVector;
+	float GoalRadius = 0.0f;
+	float CellSize = 0.0f;
+
+	/** Cells per side (0 = not baked) */
+	int32 GridSize = 0;
+
+	/** Per-cell heading toward the goal ring (zero for blocked or unreachable cells) */
+	TArray<FVector2f> Directions;
+
+	/** Per-cell obstacle flag */
+	TBitArray<> Blocked;
+	int32 NumBlocked = 0;
+
+	int32 ToCellIndex(const FVector2D& Location) const;
+	FVector2D GetCellCenter(int32 X, int32 Y) const;
+};
@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EnemyKillSubsystem.h"
+#include "EnemyRegistrySubsystem.h"
+#include "ZeGunner.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Kill Resolve"), STAT_EnemyKillResolve, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Killed"), STAT_EnemiesKilled, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wasted Hits"), STAT_WastedHits, STATGROUP_ZeGunner);
+
+void UEnemyKillSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Collection.InitializeDependency<UEnemyRegistrySubsystem>();
+}
+
+bool UEnemyKillSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemyKillSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyKillSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Requests ====================
+
+bool UEnemyKillSubsystem::RequestKill(APawn* Enemy)
+{
+	if (!IsValid(Enemy))
+	{
+		return false;
+	}
+
+	if (IsDoomed(Enemy))
+	{
+		INC_DWORD_STAT(STAT_WastedHits);
+		return false;
+	}
+
+	EEnemyType Type;
+	const UEnemyRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UEnemyRegistrySubsystem>();
+	if (!Registry || !Registry->FindEnemyType(Enemy, Type))
+	{
+		return false;
+	}
+
+	DoomedVictims.Add(Enemy);
+	PendingVictims.Add(Enemy);
+	PendingTypes.Add(Type);
+	return true;
+}
+
+bool UEnemyKillSubsystem::IsDoomed(const APawn* Enemy) const
+{
+	return Enemy && (Enemy->IsActorBeingDestroyed() || DoomedVictims.Contains(Enemy));
+}
+
+void UEnemyKillSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ResolveKills();
+}
+
+// ==================== Resolve ====================
+
+void UEnemyKillSubsystem::ResolveKills()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyKillResolve);
+
+	// Take the queue first; destruction can run gameplay code that requests more kills
+	Swap(PendingVictims, ResolvingVictims);
+	Swap(PendingTypes, ResolvingTypes);
+	PendingVictims.Reset();
+	PendingTypes.Reset();
+
+	// Victims destroyed some other way since they were queued are skipped
+	FEnemyKillBatch Batch;
+	for (int32 Index = 0; Index < ResolvingVictims.Num(); ++Index)
+	{
+		APawn* Victim = ResolvingVictims[Index];
+		if (IsValid(Victim) && !Victim->IsActorBeingDestroyed())
+		{
+			Batch.Victims.Add(Victim);
+			Batch.Types.Add(ResolvingTypes[Index]);
+			++Batch.NumKills[static_cast<int32>(ResolvingTypes[Index])];
+		}
+	}
+	ResolvingVictims.Reset();
+	ResolvingTypes.Reset();
+
+	SET_DWORD_STAT(STAT_EnemiesKilled, Batch.Victims.Num());
+
+	if (Batch.Victims.Num() > 0)
+	{
+		OnEnemiesKilled.Broadcast(Batch);
+
+		// Each victim's EndPlay spawns its explosion; IsActorBeingDestroyed keeps it doomed from here on
+		for (APawn* Victim : Batch.Victims)
+		{
+			if (IsValid(Victim))
+			{
+				Victim->Destroy();
+			}
+		}
+	}
+
+	// Only kills requested during the destruction above are still pending; stale entries drop out here
+	DoomedVictims.Reset();
+	for (const APawn* Victim : PendingVictims)
+	{
+		DoomedVictims.Add(Victim);
+	}
+}
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyTypes.h"
+#include "EnemyKillSubsystem.generated.h"
+
+/** Every enemy killed in one resolve pass, each listed once */
+struct FEnemyKillBatch
+{
+	TArray<APawn*> Victims;
+	TArray<EEnemyType> Types;
+	int32 NumKills[NumEnemyTypes] = {};
+
+	int32 GetNumKills(EEnemyType Type) const { return NumKills[static_cast<int32>(Type)]; }
+};
+
+/** Broadcast once per resolve pass, before the victims are destroyed */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnemiesKilled, const FEnemyKillBatch& /*Batch*/);
+
+/**
+ * The one place gameplay kills enemies. Hits request a kill. Requests are queued and resolved
+ * once per frame: each victim is marked dead exactly once and destroyed, which spawns a single
+ * explosion from its EndPlay. Score and spawner counters are updated from one batched broadcast.
+ * Requests for a victim that is already doomed are counted as wasted hits.
+ */
+UCLASS()
+class ZEGUNNER_API UEnemyKillSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return PendingVictims.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Broadcast with everything killed in a resolve pass */
+	FOnEnemiesKilled OnEnemiesKilled;
+
+	/**
+	 * Queue Enemy to die in this frame's resolve pass.
+	 * Returns false when Enemy isn't a registered enemy or is already dead or doomed (a wasted hit).
+	 */
+	bool RequestKill(APawn* Enemy);
+
+	/** Whether Enemy is queued to die or already being destroyed */
+	bool IsDoomed(const APawn* Enemy) const;
+
+	/** Kill every queued victim now */
+	void ResolveKills();
+
+private:
+	/** Victims in request order, with their types; may wait across a GC if queued after this frame's pass */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APawn>> PendingVictims;
+	TArray<EEnemyType> PendingTypes;
+
+	/** Queue being resolved, swapped with PendingVictims so neither reallocates every frame */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APawn>> ResolvingVictims;
+	TArray<EEnemyType> ResolvingTypes;
+
+	/** Fast membership test for PendingVictims */
+	TSet<TWeakObjectPtr<const APawn>> DoomedVictims;
+};
@@ -0,0 +1,1028 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EnemyMovementSubsystem.h"
+#include "EnemyFlowFieldSubsystem.h"
+#include "EnemySpatialGridSubsystem.h"
+#include "ZeGunner.h"
+#include "BaseDamageSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Movement Step"), STAT_EnemyMovementStep, STATGROUP_ZeGunner);
+DECLARE_CYCLE_STAT(TEXT("Enemy Transform Commit"), STAT_EnemyTransformCommit, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Stepped"), STAT_EnemiesStepped, STATGROUP_ZeGunner);
+
+static TAutoConsoleVariable<int32> CVarEnemyParallelStep(
+	TEXT("ZeGunner.Enemy.ParallelStep"),
+	1,
+	TEXT("Step enemy movement on worker threads (0 = serial on the game thread, 1 = ParallelFor). Results are identical either way."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEnemyParallelBatchSize(
+	TEXT("ZeGunner.Enemy.ParallelBatchSize"),
+	32,
+	TEXT("Minimum number of enemies per worker batch when stepping in parallel."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEnemySignificanceLOD(
+	TEXT("ZeGunner.Enemy.SignificanceLOD"),
+	1,
+	TEXT("Step distant and off-screen enemies at 15/5 Hz and extrapolate in between (0 = step every enemy every frame)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnemyLODNearDistance(
+	TEXT("ZeGunner.Enemy.LODNearDistance"),
+	3000.0f,
+	TEXT("Enemies closer than this to the base count as near for significance scoring (units)."),
+	ECVF_Default);
+
+namespace
+{
+	/** Upper bound on zigzag legs per route (guards against degenerate settings) */
+	constexpr int32 MaxZigzagLegs = 256;
+
+	/** Step intervals per significance tier */
+	constexpr float ReducedStepInterval = 1.0f / 15.0f;
+	constexpr float MinimalStepInterval = 1.0f / 5.0f;
+
+	/** Widen the frustum cone so enemies entering from the edge are already at full rate */
+	constexpr float FrustumMarginDegrees = 5.0f;
+
+	/** Full rate once the next state change is within this many of the slowest steps */
+	constexpr float TransitionStepMargin = 2.0f;
+
+	/**
+	 * Distance along a ray from Start in unit direction Dir at which it enters the circle
+	 * of the given radius around Center, or -1 if it never does.
+	 */
+	float RingEntryDistance(const FVector2D& Start, const FVector2D& Dir, const FVector2D& Center, float Radius)
+	{
+		const FVector2D FromCenter = Start - Center;
+		const double C = FromCenter.SizeSquared() - FMath::Square(Radius);
+		if (C <= 0.0)
+		{
+			return 0.0f; // Already inside
+		}
+
+		const double B = FVector2D::DotProduct(Dir, FromCenter);
+		const double Discriminant = B * B - C;
+		if (B >= 0.0 || Discriminant < 0.0)
+		{
+			return -1.0f; // Heading away or passing by
+		}
+
+		return static_cast<float>(-B - FMath::Sqrt(Discriminant));
+	}
+
+	/** Point on the route at a distance, advancing the segment cursor as needed */
+	FVector2D EvaluatePath(const FEnemyTankPath& Path, float Distance, int32& InOutSegment, float& OutYaw)
+	{
+		const TArray<FEnemyPathVertex>& Vertices = Path.Vertices;
+		if (Vertices.Num() < 2)
+		{
+			OutYaw = Vertices.Num() > 0 ? Vertices[0].Yaw : 0.0f;
+			return Vertices.Num() > 0 ? Vertices[0].Point : FVector2D::ZeroVector;
+		}
+
+		while (InOutSegment < Vertices.Num() - 2 && Distance > Vertices[InOutSegment + 1].Distance)
+		{
+			++InOutSegment;
+		}
+
+		const FEnemyPathVertex& From = Vertices[InOutSegment];
+		const FEnemyPathVertex& To = Vertices[InOutSegment + 1];
+		const float SegmentLength = To.Distance - From.Distance;
+		const float Alpha = SegmentLength > KINDA_SMALL_NUMBER ? FMath::Clamp((Distance - From.Distance) / SegmentLength, 0.0f, 1.0f) : 1.0f;
+
+		OutYaw = From.Yaw;
+		return FMath::Lerp(From.Point, To.Point, Alpha);
+	}
+}
+
+void UEnemyMovementSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FlowField = Collection.InitializeDependency<UEnemyFlowFieldSubsystem>();
+	GameplayTimers = Collection.InitializeDependency<UGameplayTimerSubsystem>();
+	SpatialGrid = Collection.InitializeDependency<UEnemySpatialGridSubsystem>();
+
+	// Stop ticking in bulk while paused instead of checking the phase every frame
+	if (UGamePhaseSubsystem* GamePhase = Collection.InitializeDependency<UGamePhaseSubsystem>())
+	{
+		GamePhase->OnPhaseChanged.AddDynamic(this, &UEnemyMovementSubsystem::HandlePhaseChanged);
+		bPaused = GamePhase->IsPaused();
+	}
+}
+
+void UEnemyMovementSubsystem::Deinitialize()
+{
+	if (UGamePhaseSubsystem* GamePhase = GetWorld()->GetSubsystem<UGamePhaseSubsystem>())
+	{
+		GamePhase->OnPhaseChanged.RemoveDynamic(this, &UEnemyMovementSubsystem::HandlePhaseChanged);
+	}
+
+	Super::Deinitialize();
+}
+
+void UEnemyMovementSubsystem::HandlePhaseChanged(EGameState OldPhase, EGameState NewPhase)
+{
+	bPaused = NewPhase == EGameState::Paused;
+}
+
+bool UEnemyMovementSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemyMovementSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyMovementSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Registration ====================
+
+FEnemyHandle UEnemyMovementSubsystem::RegisterEnemy(APawn* Enemy, EEnemyType Type, const FEnemyMotionParams& InParams, float MoveSpeed)
+{
+	FEnemyHandle Handle;
+	if (!Enemy)
+	{
+		return Handle;
+	}
+
+	if (FreeIds.Num() > 0)
+	{
+		Handle.Id = FreeIds.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Handle.Id = IdToDense.AddUninitialized();
+		IdSerials.Add(1);
+	}
+	Handle.Serial = IdSerials[Handle.Id];
+
+	const int32 Index = Actors.Add(Enemy);
+	IdToDense[Handle.Id] = Index;
+	DenseToId.Add(Handle.Id);
+
+	Types.Add(Type);
+	Positions.Add(Enemy->GetActorLocation());
+	Yaws.Add(Enemy->GetActorRotation().Yaw);
+	Speeds.Add(FMath::Max(0.0f, MoveSpeed));
+	FireTimers.AddDefaulted();
+	ManeuverTimers.AddDefaulted();
+	Flags.Add(EEnemyMotionFlags::None);
+	TankPaths.AddDefaulted();
+	Maneuvers.AddDefaulted();
+	Params.Add(InParams);
+	RandomStreams.Emplace(HashCombine(GetTypeHash(Type), GetTypeHash(RegistrationCount++)));
+	StepEvents.Add(EEnemyStepEvents::None);
+	PendingStepTimes.Add(0.0f);
+	Velocities.Add(FVector::ZeroVector);
+
+	if (SpatialGrid)
+	{
+		SpatialGrid->AddEnemy(Handle, Type, Positions[Index]);
+	}
+
+	return Handle;
+}
+
+void UEnemyMovementSubsystem::UnregisterEnemy(FEnemyHandle& Handle)
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index == INDEX_NONE)
+	{
+		Handle.Reset();
+		return;
+	}
+
+	if (GameplayTimers)
+	{
+		GameplayTimers->Cancel(FireTimers[Index]);
+		GameplayTimers->Cancel(ManeuverTimers[Index]);
+	}
+
+	if (SpatialGrid)
+	{
+		SpatialGrid->RemoveEnemy(Handle);
+	}
+
+	// Swap the last entity into the freed slot to keep the buffers dense
+	const int32 LastIndex = Actors.Num() - 1;
+	if (Index != LastIndex)
+	{
+		IdToDense[DenseToId[LastIndex]] = Index;
+	}
+
+	Actors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Types.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Yaws.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Speeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	FireTimers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ManeuverTimers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TankPaths.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Maneuvers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Params.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RandomStreams.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	StepEvents.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PendingStepTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	DenseToId.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	IdToDense[Handle.Id] = INDEX_NONE;
+	++IdSerials[Handle.Id];
+	FreeIds.Add(Handle.Id);
+	Handle.Reset();
+}
+
+int32 UEnemyMovementSubsystem::ToDenseIndex(FEnemyHandle Handle) const
+{
+	return IdToDense.IsValidIndex(Handle.Id) && IdSerials[Handle.Id] == Handle.Serial ? IdToDense[Handle.Id] : INDEX_NONE;
+}
+
+// ==================== Actor View Accessors ====================
+
+APawn* UEnemyMovementSubsystem::GetActor(FEnemyHandle Handle) const
+{
+	const int32 Index = ToDenseIndex(Handle);
+	return Index != INDEX_NONE ? Actors[Index].Get() : nullptr;
+}
+
+FEnemyMotionParams* UEnemyMovementSubsystem::GetParams(FEnemyHandle Handle)
+{
+	const int32 Index = ToDenseIndex(Handle);
+	return Index != INDEX_NONE ? &Params[Index] : nullptr;
+}
+
+void UEnemyMovementSubsystem::SetMoveSpeed(FEnemyHandle Handle, float NewSpeed)
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index != INDEX_NONE)
+	{
+		Speeds[Index] = FMath::Max(0.0f, NewSpeed);
+	}
+}
+
+void UEnemyMovementSubsystem::SetTargetLocation(FEnemyHandle Handle, const FVector& NewTarget)
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	Params[Index].TargetLocation = NewTarget;
+	Flags[Index] |= EEnemyMotionFlags::TargetSet;
+
+	switch (Types[Index])
+	{
+	case EEnemyType::Tank:
+		BuildTankPath(Index);
+		break;
+
+	case EEnemyType::UFO:
+		// Pick first waypoint now that we know where the base is
+		Maneuvers[Index].DistanceToBase = FVector::Dist2D(Positions[Index], NewTarget);
+		PickNewWaypoint(Index);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UEnemyMovementSubsystem::RebuildTankPath(FEnemyHandle Handle)
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index != INDEX_NONE && Types[Index] == EEnemyType::Tank)
+	{
+		BuildTankPath(Index);
+	}
+}
+
+void UEnemyMovementSubsystem::SyncFromActor(FEnemyHandle Handle)
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index != INDEX_NONE && Actors[Index])
+	{
+		Positions[Index] = Actors[Index]->GetActorLocation();
+		Yaws[Index] = Actors[Index]->GetActorRotation().Yaw;
+		PendingStepTimes[Index] = 0.0f;
+		Velocities[Index] = FVector::ZeroVector;
+
+		if (SpatialGrid)
+		{
+			SpatialGrid->UpdateEnemy(Handle, Positions[Index]);
+		}
+
+		// The route started somewhere else, replan from here
+		if (Types[Index] == EEnemyType::Tank && TankPaths[Index].bBuilt)
+		{
+			BuildTankPath(Index);
+		}
+	}
+}
+
+FVector UEnemyMovementSubsystem::PredictLocation(FEnemyHandle Handle, float Seconds) const
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index == INDEX_NONE)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FEnemyTankPath& Path = TankPaths[Index];
+	if (Types[Index] != EEnemyType::Tank || !Path.bBuilt)
+	{
+		return Positions[Index];
+	}
+
+	const float Distance = FMath::Min(Path.Travelled + Speeds[Index] * FMath::Max(0.0f, Seconds), Path.GetLength());
+
+	// Binary search instead of walking the cursor, the prediction may be far ahead
+	int32 Segment = FMath::Max(0, Algo::UpperBoundBy(Path.Vertices, Distance, &FEnemyPathVertex::Distance) - 1);
+	Segment = FMath::Min(Segment, FMath::Max(0, Path.Vertices.Num() - 2));
+
+	float Yaw = 0.0f;
+	const FVector2D Point = EvaluatePath(Path, Distance, Segment, Yaw);
+	return FVector(Point.X, Point.Y, Positions[Index].Z);
+}
+
+bool UEnemyMovementSubsystem::HasReachedTarget(FEnemyHandle Handle) const
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Tanks stop at the end of their route
+	if (Types[Index] == EEnemyType::Tank && TankPaths[Index].bBuilt)
+	{
+		return TankPaths[Index].Travelled >= TankPaths[Index].GetLength();
+	}
+
+	// Helis and UFOs have no destination until a target is set; tanks default to the origin
+	if (Types[Index] != EEnemyType::Tank && !EnumHasAnyFlags(Flags[Index], EEnemyMotionFlags::TargetSet))
+	{
+		return false;
+	}
+
+	return FVector::Dist2D(Positions[Index], Params[Index].TargetLocation) <= Params[Index].StoppingDistance;
+}
+
+// ==================== Frame Step ====================
+
+void UEnemyMovementSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Actors.Num() == 0)
+	{
+		return;
+	}
+
+	UpdateSignificanceView();
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_EnemyMovementStep);
+
+		// Each step only writes its own slot, so serial and parallel produce the same buffers
+		const EParallelForFlags StepFlags = CVarEnemyParallelStep.GetValueOnGameThread() != 0
+			? EParallelForFlags::None
+			: EParallelForFlags::ForceSingleThread;
+		const int32 MinBatchSize = FMath::Max(1, CVarEnemyParallelBatchSize.GetValueOnGameThread());
+
+		ParallelFor(TEXT("EnemyMovementStep"), Actors.Num(), MinBatchSize, [this, DeltaTime](int32 Index)
+		{
+			StepEnemy(Index, DeltaTime);
+		}, StepFlags);
+	}
+
+	ApplyStepEvents();
+	CommitTransforms();
+}
+
+// ==================== Significance LOD ====================
+
+void UEnemyMovementSubsystem::UpdateSignificanceView()
+{
+	SignificanceView.bValid = false;
+
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->PlayerCameraManager)
+	{
+		return;
+	}
+
+	// The cached view carries the camera component's FOV, so turret zoom narrows it
+	const FMinimalViewInfo& View = PC->PlayerCameraManager->GetCameraCacheView();
+	const float TanHalfHorizontal = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(View.FOV, 1.0f, 170.0f) * 0.5f));
+	const float TanHalfVertical = TanHalfHorizontal / FMath::Max(View.AspectRatio, KINDA_SMALL_NUMBER);
+	const float HalfDiagonal = FMath::Atan(FMath::Sqrt(FMath::Square(TanHalfHorizontal) + FMath::Square(TanHalfVertical)));
+
+	SignificanceView.Location = View.Location;
+	SignificanceView.Forward = View.Rotation.Vector();
+	SignificanceView.CosHalfAngle = FMath::Cos(FMath::Min(HalfDiagonal + FMath::DegreesToRadians(FrustumMarginDegrees), UE_PI));
+	SignificanceView.bValid = true;
+}
+
+float UEnemyMovementSubsystem::GetDistanceToNextTransition(int32 Index) const
+{
+	const FEnemyMotionParams& P = Params[Index];
+
+	switch (Types[Index])
+	{
+	case EEnemyType::Tank:
+		return TankPaths[Index].bBuilt ? TankPaths[Index].GetLength() - TankPaths[Index].Travelled : 0.0f;
+
+	case EEnemyType::Heli:
+	{
+		const float DistToTarget = FVector::Dist2D(Positions[Index], P.TargetLocation);
+		float Distance = DistToTarget - P.StoppingDistance;
+		if (!EnumHasAnyFlags(Flags[Index], EEnemyMotionFlags::Dancing) && P.LateralDanceDistance > 0.0f && DistToTarget > P.LateralDanceDistance)
+		{
+			Distance = FMath::Min(Distance, DistToTarget - P.LateralDanceDistance);
+		}
+		return Distance;
+	}
+
+	case EEnemyType::UFO:
+		return FVector::Dist(Positions[Index], Maneuvers[Index].Waypoint) - P.WaypointReachedThreshold;
+
+	default:
+		return 0.0f;
+	}
+}
+
+EEnemySignificance UEnemyMovementSubsystem::EvaluateSignificance(int32 Index) const
+{
+	// Anything about to change state, or whose state changes on timers, keeps full fidelity
+	const EEnemyMotionFlags F = Flags[Index];
+	if (!EnumHasAnyFlags(F, EEnemyMotionFlags::TargetSet) && Types[Index] != EEnemyType::Tank)
+	{
+		return EEnemySignificance::Full;
+	}
+	if (EnumHasAnyFlags(F, EEnemyMotionFlags::Firing | EEnemyMotionFlags::Dancing | EEnemyMotionFlags::Hovering))
+	{
+		return EEnemySignificance::Full;
+	}
+	if (GetDistanceToNextTransition(Index) <= Speeds[Index] * MinimalStepInterval * TransitionStepMargin)
+	{
+		return EEnemySignificance::Full;
+	}
+
+	const float NearDistance = CVarEnemyLODNearDistance.GetValueOnAnyThread();
+	const bool bNearBase = FVector::Dist2D(Positions[Index], Params[Index].TargetLocation) <= NearDistance;
+
+	bool bVisible = true;
+	if (SignificanceView.bValid)
+	{
+		const FVector ToEnemy = Positions[Index] - SignificanceView.Location;
+		bVisible = FVector::DotProduct(ToEnemy, SignificanceView.Forward) >= SignificanceView.CosHalfAngle * ToEnemy.Size();
+	}
+
+	if (bVisible && bNearBase)
+	{
+		return EEnemySignificance::Full;
+	}
+	return bVisible || bNearBase ? EEnemySignificance::Reduced : EEnemySignificance::Minimal;
+}
+
+// ==================== Enemy Step ====================
+
+void UEnemyMovementSubsystem::StepEnemy(int32 Index, float DeltaTime)
+{
+	Flags[Index] &= ~(EEnemyMotionFlags::Moved | EEnemyMotionFlags::Stepped);
+
+	const EEnemySignificance Significance = CVarEnemySignificanceLOD.GetValueOnAnyThread() != 0
+		? EvaluateSignificance(Index)
+		: EEnemySignificance::Full;
+
+	float& PendingTime = PendingStepTimes[Index];
+	PendingTime += DeltaTime;
+
+	const float Interval = Significance == EEnemySignificance::Minimal ? MinimalStepInterval
+		: Significance == EEnemySignificance::Reduced ? ReducedStepInterval
+		: 0.0f;
+	if (PendingTime < Interval)
+	{
+		// Extrapolate along the last step until the next one
+		if (!Velocities[Index].IsNearlyZero())
+		{
+			Flags[Index] |= EEnemyMotionFlags::Moved;
+		}
+		return;
+	}
+
+	// Step the whole accumulated time at once; tanks read their route by distance so nothing is lost
+	const float StepTime = PendingTime;
+	const FVector StartPosition = Positions[Index];
+	PendingTime = 0.0f;
+	Flags[Index] |= EEnemyMotionFlags::Stepped;
+
+	switch (Types[Index])
+	{
+	case EEnemyType::Tank:
+		StepTank(Index, StepTime);
+		break;
+	case EEnemyType::Heli:
+		StepHeli(Index, StepTime);
+		break;
+	case EEnemyType::UFO:
+		StepUFO(Index, StepTime);
+		break;
+	}
+
+	Velocities[Index] = StepTime > UE_SMALL_NUMBER ? (Positions[Index] - StartPosition) / StepTime : FVector::ZeroVector;
+}
+
+void UEnemyMovementSubsystem::UpdateFiring(int32 Index, bool bAtLineOfFire)
+{
+	// Fire at base when stopped at line of fire
+	if (bAtLineOfFire && !EnumHasAnyFlags(Flags[Index], EEnemyMotionFlags::Firing))
+	{
+		Flags[Index] |= EEnemyMotionFlags::Firing;
+		StepEvents[Index] |= EEnemyStepEvents::StartedFiring;
+	}
+}
+
+void UEnemyMovementSubsystem::StepTank(int32 Index, float DeltaTime)
+{
+	FEnemyTankPath& Path = TankPaths[Index];
+	EEnemyMotionFlags& F = Flags[Index];
+
+	// Tanks head for the default target even if none was set explicitly
+	if (!Path.bBuilt)
+	{
+		BuildTankPath(Index);
+	}
+
+	const float Length = Path.GetLength();
+	if (Path.Travelled < Length)
+	{
+		Path.Travelled = FMath::Min(Path.Travelled + Speeds[Index] * DeltaTime, Length);
+
+		float SegmentYaw = Yaws[Index];
+		const FVector2D Point = EvaluatePath(Path, Path.Travelled, Path.Segment, SegmentYaw);
+
+		// Check if tank has switched from zigzag to the straight run
+		if (EnumHasAnyFlags(F, EEnemyMotionFlags::Zigzagging) && Path.DirectSegment != INDEX_NONE && Path.Segment >= Path.DirectSegment)
+		{
+			F &= ~EEnemyMotionFlags::Zigzagging;
+			StepEvents[Index] |= EEnemyStepEvents::SwitchedToDirect;
+		}
+
+		// Position comes straight off the route; only the visible heading is smoothed
+		Positions[Index].X = Point.X;
+		Positions[Index].Y = Point.Y;
+		Yaws[Index] = FMath::RInterpTo(FRotator(0.0f, Yaws[Index], 0.0f), FRotator(0.0f, SegmentYaw, 0.0f), DeltaTime, Params[Index].RotationSpeed).Yaw;
+
+		F |= EEnemyMotionFlags::Moved;
+	}
+
+	UpdateFiring(Index, Path.Travelled >= Length);
+}
+
+void UEnemyMovementSubsystem::StepHeli(int32 Index, float DeltaTime)
+{
+	EEnemyMotionFlags& F = Flags[Index];
+	if (!EnumHasAnyFlags(F, EEnemyMotionFlags::TargetSet))
+	{
+		return;
+	}
+
+	const FEnemyMotionParams& P = Params[Index];
+	FVector& Position = Positions[Index];
+	FEnemyManeuver& Maneuver = Maneuvers[Index];
+
+	FVector TargetAtHeight = P.TargetLocation;
+	TargetAtHeight.Z = P.FlyHeight;
+
+	// Check if we should start lateral dancing (within dance distance of target)
+	float DistToTarget = FVector::Dist2D(Position, P.TargetLocation);
+	if (!EnumHasAnyFlags(F, EEnemyMotionFlags::Dancing) && P.LateralDanceDistance > 0.0f)
+	{
+		if (DistToTarget <= P.LateralDanceDistance && DistToTarget > P.StoppingDistance)
+		{
+			F |= EEnemyMotionFlags::Dancing;
+			// Calculate lateral axis (perpendicular to approach direction, in XY plane)
+			const FVector ToTarget = (P.TargetLocation - Position).GetSafeNormal2D();
+			Maneuver.LateralAxis = FVector(-ToTarget.Y, ToTarget.X, 0.0f);
+			PickNewLateralLeg(Index);
+			StepEvents[Index] |= EEnemyStepEvents::StartedDancing;
+		}
+	}
+
+	// Move toward target (only XY, maintain fly height)
+	if (DistToTarget > P.StoppingDistance)
+	{
+		FVector Direction = (TargetAtHeight - Position).GetSafeNormal();
+		Direction.Z = 0.0f; // Keep level flight
+
+		Position += Direction * Speeds[Index] * DeltaTime;
+		Position.Z = P.FlyHeight;
+		F |= EEnemyMotionFlags::Moved;
+	}
+
+	// Apply lateral dancing if active
+	DistToTarget = FVector::Dist2D(Position, P.TargetLocation);
+	if (EnumHasAnyFlags(F, EEnemyMotionFlags::Dancing) && DistToTarget > P.StoppingDistance)
+	{
+		FVector LateralOffset = Maneuver.LateralAxis * Maneuver.LateralDirection * Maneuver.LateralSpeed * DeltaTime;
+		LateralOffset.Z = 0.0f;
+		Position += LateralOffset;
+		Position.Z = P.FlyHeight;
+		F |= EEnemyMotionFlags::Moved;
+	}
+
+	// Smoothly rotate toward target (only Yaw)
+	FVector Direction = (TargetAtHeight - Position).GetSafeNormal();
+	Direction.Z = 0.0f;
+	if (!Direction.IsNearlyZero())
+	{
+		Yaws[Index] = FMath::FInterpTo(Yaws[Index], Direction.Rotation().Yaw, DeltaTime, P.RotationSpeed);
+		F |= EEnemyMotionFlags::Moved;
+	}
+
+	UpdateFiring(Index, FVector::Dist2D(Position, P.TargetLocation) <= P.StoppingDistance);
+}
+
+void UEnemyMovementSubsystem::StepUFO(int32 Index, float DeltaTime)
+{
+	EEnemyMotionFlags& F = Flags[Index];
+	if (!EnumHasAnyFlags(F, EEnemyMotionFlags::TargetSet))
+	{
+		return;
+	}
+
+	const FEnemyMotionParams& P = Params[Index];
+	FVector& Position = Positions[Index];
+	FEnemyManeuver& Maneuver = Maneuvers[Index];
+
+	// Hovering at waypoint until the hover timer picks the next one
+	if (!EnumHasAnyFlags(F, EEnemyMotionFlags::Hovering))
+	{
+		// Flying toward waypoint
+		const FVector Direction = (Maneuver.Waypoint - Position).GetSafeNormal();
+		Position += Direction * Speeds[Index] * DeltaTime;
+		Position.Z = P.FlyHeight; // Maintain fly height
+
+		FVector FlatDirection = (Maneuver.Waypoint - Position).GetSafeNormal();
+		FlatDirection.Z = 0.0f;
+		if (!FlatDirection.IsNearlyZero())
+		{
+			Yaws[Index] = FMath::FInterpTo(Yaws[Index], FlatDirection.Rotation().Yaw, DeltaTime, P.RotationSpeed);
+		}
+		F |= EEnemyMotionFlags::Moved;
+
+		// Check if we reached the waypoint
+		if (FVector::Dist(Position, Maneuver.Waypoint) <= P.WaypointReachedThreshold)
+		{
+			F |= EEnemyMotionFlags::Hovering;
+			Maneuver.TimerDuration = RandomStreams[Index].FRandRange(P.MinHoverTime, P.MaxHoverTime);
+			StepEvents[Index] |= EEnemyStepEvents::StartedHovering;
+		}
+	}
+
+	// Fire at base only when at stopping distance (line of fire)
+	UpdateFiring(Index, EnumHasAnyFlags(F, EEnemyMotionFlags::ReachedLineOfFire));
+}
+
+// ==================== Maneuvers ====================
+
+void UEnemyMovementSubsystem::BuildTankPath(int32 Index)
+{
+	const FEnemyMotionParams& P = Params[Index];
+	FEnemyTankPath& Path = TankPaths[Index];
+	FRandomStream& Stream = RandomStreams[Index];
+
+	Path.Vertices.Reset();
+	Path.Travelled = 0.0f;
+	Path.Segment = 0;
+	Path.DirectSegment = INDEX_NONE;
+	Path.bBuilt = true;
+
+	const FVector2D Start(Positions[Index]);
+	const FVector2D Target(P.TargetLocation);
+
+	FEnemyPathVertex& First = Path.Vertices.AddDefaulted_GetRef();
+	First.Point = Start;
+	First.Yaw = Yaws[Index];
+
+	auto AddVertex = [&Path](const FVector2D& Point)
+	{
+		FEnemyPathVertex& Previous = Path.Vertices.Last();
+		const FVector2D Delta = Point - Previous.Point;
+		if (!Delta.IsNearlyZero())
+		{
+			Previous.Yaw = FMath::RadiansToDegrees(FMath::Atan2(Delta.Y, Delta.X));
+		}
+
+		FEnemyPathVertex Vertex;
+		Vertex.Point = Point;
+		Vertex.Distance = Previous.Distance + static_cast<float>(Delta.Size());
+		Vertex.Yaw = Previous.Yaw;
+		Path.Vertices.Add(Vertex);
+	};
+
+	const FVector2D ToTarget = Target - Start;
+	const float DistToTarget = static_cast<float>(ToTarget.Size());
+	if (DistToTarget <= P.StoppingDistance)
+	{
+		Flags[Index] &= ~EEnemyMotionFlags::Zigzagging;
+		return;
+	}
+
+	// Zigzag until entering the straight-line ring (or the stopping ring if there is none)
+	const float CutoverRadius = FMath::Max(P.StoppingDistance, P.StraightLineDistance);
+	const bool bZigzag = P.bUseZigzagMovement && DistToTarget > CutoverRadius;
+	if (bZigzag)
+	{
+		Flags[Index] |= EEnemyMotionFlags::Zigzagging;
+	}
+	else
+	{
+		Flags[Index] &= ~EEnemyMotionFlags::Zigzagging;
+	}
+
+	FVector2D Cursor = Start;
+	if (bZigzag)
+	{
+		const FVector2D Axis = ToTarget / DistToTarget;
+		const FVector2D Lateral(-Axis.Y, Axis.X);
+		const float Diagonal = UE_HALF_SQRT_2;
+
+		// Randomly choose initial direction (left or right) at center +/- 45 degrees
+		int8 Direction = Stream.RandRange(0, 1) == 1 ? 1 : -1;
+		float PreviousOvershoot = 0.0f;
+
+		for (int32 Leg = 0; Leg < MaxZigzagLegs; ++Leg)
+		{
+			// Each leg runs back to the center line (as far as the last one went past it) then past it again
+			const float Overshoot = FMath::Max(Stream.FRandRange(P.ZigzagMinDistance, P.ZigzagMaxDistance), 1.0f);
+			const FVector2D Heading = Axis * Diagonal + Lateral * (Direction * Diagonal);
+			float LegLength = PreviousOvershoot + Overshoot;
+
+			const float Entry = RingEntryDistance(Cursor, Heading, Target, CutoverRadius);
+			if (Entry >= 0.0f && Entry <= LegLength)
+			{
+				Cursor += Heading * Entry;
+				AddVertex(Cursor);
+				break;
+			}
+
+			// Never zigzag past the base when the legs are too wide to enter the ring
+			const float AlongRemaining = DistToTarget - static_cast<float>(FVector2D::DotProduct(Cursor - Start, Axis));
+			const bool bPassesBase = LegLength * Diagonal >= AlongRemaining;
+			if (bPassesBase)
+			{
+				LegLength = FMath::Max(AlongRemaining, 0.0f) / Diagonal;
+			}
+
+			Cursor += Heading * LegLength;
+			AddVertex(Cursor);
+
+			if (bPassesBase)
+			{
+				break;
+			}
+
+			PreviousOvershoot = Overshoot;
+			Direction = -Direction;
+		}
+
+		Path.DirectSegment = Path.Vertices.Num() - 1;
+	}
+
+	// Let the shared flow field route the straight run around obstacles
+	if (FlowField && FlowField->IsBaked()
+		&& FVector2D::Distance(FlowField->GetTarget(), Target) <= KINDA_SMALL_NUMBER
+		&& !FlowField->IsPathClear(Cursor, Target))
+	{
+		TArray<FVector2D> Corners;
+		FlowField->TraceRoute(Cursor, P.StoppingDistance, Corners);
+		for (const FVector2D& Corner : Corners)
+		{
+			AddVertex(Corner);
+		}
+		return;
+	}
+
+	// Straight run to the stopping ring
+	const FVector2D Remaining = Target - Cursor;
+	const float RemainingDist = static_cast<float>(Remaining.Size());
+	if (RemainingDist > P.StoppingDistance)
+	{
+		AddVertex(Cursor + Remaining / RemainingDist * (RemainingDist - P.StoppingDistance));
+	}
+}
+
+void UEnemyMovementSubsystem::PickNewLateralLeg(int32 Index)
+{
+	const FEnemyMotionParams& P = Params[Index];
+	FEnemyManeuver& Maneuver = Maneuvers[Index];
+
+	// Flip direction, random speed and duration for this leg
+	Maneuver.LateralDirection = -Maneuver.LateralDirection;
+	Maneuver.LateralSpeed = RandomStreams[Index].FRandRange(P.LateralMinSpeed, P.LateralMaxSpeed);
+	Maneuver.TimerDuration = RandomStreams[Index].FRandRange(P.LateralMinTime, P.LateralMaxTime);
+}
+
+void UEnemyMovementSubsystem::PickNewWaypoint(int32 Index)
+{
+	const FEnemyMotionParams& P = Params[Index];
+	FEnemyManeuver& Maneuver = Maneuvers[Index];
+	EEnemyMotionFlags& F = Flags[Index];
+	FRandomStream& Stream = RandomStreams[Index];
+
+	// If already at stopping distance, hover around it with some lateral variation
+	if (EnumHasAnyFlags(F, EEnemyMotionFlags::ReachedLineOfFire))
+	{
+		const float AngleRad = FMath::DegreesToRadians(Stream.FRandRange(0.0f, 360.0f));
+		const float Radius = FMath::Max(P.LineOfFireDistance + Stream.FRandRange(-100.0f, 100.0f), 50.0f);
+
+		Maneuver.Waypoint = FVector(
+			P.TargetLocation.X + FMath::Cos(AngleRad) * Radius,
+			P.TargetLocation.Y + FMath::Sin(AngleRad) * Radius,
+			P.FlyHeight);
+		return;
+	}
+
+	// Decrease distance to base by a random increment
+	const float ApproachAmount = Stream.FRandRange(P.MinApproachIncrement, P.MaxApproachIncrement);
+	Maneuver.DistanceToBase = FMath::Max(Maneuver.DistanceToBase - ApproachAmount, P.LineOfFireDistance);
+
+	if (Maneuver.DistanceToBase <= P.LineOfFireDistance)
+	{
+		F |= EEnemyMotionFlags::ReachedLineOfFire;
+		Maneuver.DistanceToBase = P.LineOfFireDistance;
+		StepEvents[Index] |= EEnemyStepEvents::ReachedLineOfFire;
+	}
+
+	// Angle from the base to the current position, plus a random lateral offset
+	FVector ToUFO = Positions[Index] - P.TargetLocation;
+	ToUFO.Z = 0.0f;
+	const float CurrentAngle = FMath::Atan2(ToUFO.Y, ToUFO.X);
+
+	float LateralOffset = Stream.FRandRange(P.MinLateralSpread, P.MaxLateralSpread);
+	if (Stream.RandRange(0, 1) == 1) LateralOffset = -LateralOffset;
+	const float NewAngle = CurrentAngle + FMath::Atan2(LateralOffset, Maneuver.DistanceToBase);
+
+	Maneuver.Waypoint = FVector(
+		P.TargetLocation.X + FMath::Cos(NewAngle) * Maneuver.DistanceToBase,
+		P.TargetLocation.Y + FMath::Sin(NewAngle) * Maneuver.DistanceToBase,
+		P.FlyHeight);
+}
+
+// ==================== Step Events ====================
+
+void UEnemyMovementSubsystem::ApplyStepEvents()
+{
+	for (int32 Index = 0; Index < StepEvents.Num(); ++Index)
+	{
+		const EEnemyStepEvents Events = StepEvents[Index];
+		if (Events == EEnemyStepEvents::None)
+		{
+			continue;
+		}
+		StepEvents[Index] = EEnemyStepEvents::None;
+
+		const FEnemyMotionParams& P = Params[Index];
+		if (EnumHasAnyFlags(Events, EEnemyStepEvents::SwitchedToDirect))
+		{
+			UE_LOG(LogTemp, Log, TEXT("TankAI: Within straight-line distance, switching to direct approach"));
+		}
+		if (EnumHasAnyFlags(Events, EEnemyStepEvents::StartedDancing))
+		{
+			UE_LOG(LogTemp, Log, TEXT("HeliAI: Started lateral dancing at dist %.0f"), FVector::Dist2D(Positions[Index], P.TargetLocation));
+			ScheduleManeuverTimer(Index);
+		}
+		if (EnumHasAnyFlags(Events, EEnemyStepEvents::StartedHovering))
+		{
+			ScheduleManeuverTimer(Index);
+		}
+		if (EnumHasAnyFlags(Events, EEnemyStepEvents::ReachedLineOfFire))
+		{
+			UE_LOG(LogTemp, Log, TEXT("UFOAI: Reached stopping distance (%.0f)"), P.LineOfFireDistance);
+		}
+		if (EnumHasAnyFlags(Events, EEnemyStepEvents::StartedFiring))
+		{
+			if (Types[Index] == EEnemyType::Heli)
+			{
+				UE_LOG(LogTemp, Log, TEXT("HeliAI: Reached target! Starting fire at base. StopDist=%.1f"), P.StoppingDistance);
+
+				// Dancing stops at the target
+				if (GameplayTimers)
+				{
+					GameplayTimers->Cancel(ManeuverTimers[Index]);
+				}
+			}
+			ScheduleFireTimer(Index);
+		}
+	}
+}
+
+// ==================== Timers ====================
+
+void UEnemyMovementSubsystem::ScheduleFireTimer(int32 Index)
+{
+	if (GameplayTimers)
+	{
+		FireTimers[Index] = GameplayTimers->Schedule(Params[Index].RateOfFire,
+			FSimpleDelegate::CreateUObject(this, &UEnemyMovementSubsystem::OnFireTimer, ToHandle(Index)));
+	}
+}
+
+void UEnemyMovementSubsystem::ScheduleManeuverTimer(int32 Index)
+{
+	if (GameplayTimers)
+	{
+		ManeuverTimers[Index] = GameplayTimers->Schedule(Maneuvers[Index].TimerDuration,
+			FSimpleDelegate::CreateUObject(this, &UEnemyMovementSubsystem::OnManeuverTimer, ToHandle(Index)));
+	}
+}
+
+void UEnemyMovementSubsystem::OnFireTimer(FEnemyHandle Handle)
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (UBaseDamageSubsystem* BaseDamage = GetWorld()->GetSubsystem<UBaseDamageSubsystem>())
+	{
+		BaseDamage->QueueDamage(Types[Index]);
+	}
+	ScheduleFireTimer(Index);
+}
+
+void UEnemyMovementSubsystem::OnManeuverTimer(FEnemyHandle Handle)
+{
+	const int32 Index = ToDenseIndex(Handle);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	switch (Types[Index])
+	{
+	case EEnemyType::Heli:
+		PickNewLateralLeg(Index);
+		ScheduleManeuverTimer(Index);
+		break;
+
+	case EEnemyType::UFO:
+		Flags[Index] &= ~EEnemyMotionFlags::Hovering;
+		PickNewWaypoint(Index);
+		break;
+
+	default:
+		break;
+	}
+}
+
+// ==================== Commit ====================
+
+void UEnemyMovementSubsystem::CommitTransforms()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyTransformCommit);
+
+	int32 NumStepped = 0;
+	for (int32 Index = 0; Index < Actors.Num(); ++Index)
+	{
+		if (EnumHasAnyFlags(Flags[Index], EEnemyMotionFlags::Stepped))
+		{
+			++NumStepped;
+		}
+
+		if (!EnumHasAnyFlags(Flags[Index], EEnemyMotionFlags::Moved))
+		{
+			continue;
+		}
+
+		// Between LOD steps the visible position runs ahead of the simulated one
+		const FVector Location = Positions[Index] + Velocities[Index] * PendingStepTimes[Index];
+
+		if (APawn* Enemy = Actors[Index])
+		{
+			Enemy->SetActorLocationAndRotation(Location, FRotator(0.0f, Yaws[Index], 0.0f));
+		}
+
+		if (SpatialGrid)
+		{
+			SpatialGrid->UpdateEnemy(ToHandle(Index), Location);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_EnemiesStepped, NumStepped);
+}
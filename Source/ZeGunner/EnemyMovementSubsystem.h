@@ -0,0 +1,343 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyTypes.h"
+#include "GamePhaseSubsystem.h"
+#include "GameplayTimerSubsystem.h"
+#include "EnemyMovementSubsystem.generated.h"
+
+class UEnemyFlowFieldSubsystem;
+class UEnemySpatialGridSubsystem;
+
+/** Per-enemy movement configuration (cold data, written by the actor setters) */
+struct FEnemyMotionParams
+{
+	/** The target location to move toward (base position) */
+	FVector TargetLocation = FVector::ZeroVector;
+
+	/** Distance to stop from target */
+	float StoppingDistance = 100.0f;
+
+	/** Rotation speed when turning toward the heading */
+	float RotationSpeed = 3.0f;
+
+	/** Flying height (helis and UFOs) */
+	float FlyHeight = 500.0f;
+
+	/** Seconds between shots at the base */
+	float RateOfFire = 3.0f;
+
+	// ==================== Tank Zigzag ====================
+
+	bool bUseZigzagMovement = false;
+	float ZigzagMinDistance = 200.0f;
+	float ZigzagMaxDistance = 500.0f;
+	float StraightLineDistance = 800.0f;
+
+	// ==================== Heli Lateral Dance ====================
+
+	float LateralDanceDistance = 1000.0f;
+	float LateralMinSpeed = 100.0f;
+	float LateralMaxSpeed = 400.0f;
+	float LateralMinTime = 0.5f;
+	float LateralMaxTime = 2.0f;
+
+	// ==================== UFO Approach ====================
+
+	float MinApproachIncrement = 200.0f;
+	float MaxApproachIncrement = 500.0f;
+	float MinLateralSpread = 100.0f;
+	float MaxLateralSpread = 800.0f;
+	float MinHoverTime = 1.0f;
+	float MaxHoverTime = 3.0f;
+	float LineOfFireDistance = 500.0f;
+	float WaypointReachedThreshold = 50.0f;
+};
+
+/** Runtime state flags for one enemy */
+enum class EEnemyMotionFlags : uint8
+{
+	None              = 0,
+	TargetSet         = 1 << 0,
+	Firing            = 1 << 1,
+	Zigzagging        = 1 << 2,
+	Dancing           = 1 << 3,
+	Hovering          = 1 << 4,
+	ReachedLineOfFire = 1 << 5,
+	Moved             = 1 << 6,
+	Stepped           = 1 << 7
+};
+ENUM_CLASS_FLAGS(EEnemyMotionFlags);
+
+/** How often an enemy is simulated, picked from its significance every frame */
+enum class EEnemySignificance : uint8
+{
+	/** Every frame: on screen near the base, firing, or about to change state */
+	Full,
+	/** 15 Hz: on screen but far out, or near the base but off screen */
+	Reduced,
+	/** 5 Hz: far out and off screen */
+	Minimal
+};
+
+/** Side effects recorded by a (possibly parallel) step and applied in index order on the game thread */
+enum class EEnemyStepEvents : uint8
+{
+	None              = 0,
+	StartedFiring     = 1 << 0,
+	StartedDancing    = 1 << 1,
+	StartedHovering   = 1 << 2,
+	SwitchedToDirect  = 1 << 3,
+	ReachedLineOfFire = 1 << 4
+};
+ENUM_CLASS_FLAGS(EEnemyStepEvents);
+
+/** One corner of a precomputed tank route */
+struct FEnemyPathVertex
+{
+	/** Corner position (XY, the tank keeps its own Z) */
+	FVector2D Point = FVector2D::ZeroVector;
+
+	/** Route distance from the start to this corner */
+	float Distance = 0.0f;
+
+	/** Heading of the segment leaving this corner, in degrees */
+	float Yaw = 0.0f;
+};
+
+/**
+ * Tank route to the stopping ring, built once per target/settings change.
+ * Zigzag tanks get alternating +/-45 degree legs that each run a random distance past
+ * the center line, followed by a straight leg once inside StraightLineDistance.
+ * Evaluating by distance travelled only ever advances the segment cursor.
+ */
+struct FEnemyTankPath
+{
+	TArray<FEnemyPathVertex> Vertices;
+
+	/** Distance travelled along the route so far */
+	float Travelled = 0.0f;
+
+	/** Segment the tank is currently on (index of its start vertex) */
+	int32 Segment = 0;
+
+	/** First segment of the straight run to the base (INDEX_NONE if the route never zigzags) */
+	int32 DirectSegment = INDEX_NONE;
+
+	/** Has the route been built for the current target? */
+	bool bBuilt = false;
+
+	float GetLength() const { return Vertices.Num() > 0 ? Vertices.Last().Distance : 0.0f; }
+};
+
+/** Heli lateral dance / UFO waypoint state */
+struct FEnemyManeuver
+{
+	/** Heli: lateral axis (perpendicular to approach direction) */
+	FVector LateralAxis = FVector::ZeroVector;
+
+	/** UFO: waypoint currently flown toward */
+	FVector Waypoint = FVector::ZeroVector;
+
+	/** Heli: lateral speed for the current dance leg */
+	float LateralSpeed = 0.0f;
+
+	/** Heli: duration of the current lateral leg. UFO: time to hover at the waypoint. */
+	float TimerDuration = 0.0f;
+
+	/** UFO: current distance from the base (decreases each waypoint) */
+	float DistanceToBase = 0.0f;
+
+	/** Heli: current lateral direction, 1 = left, -1 = right */
+	int8 LateralDirection = 1;
+};
+
+/**
+ * Owns the kinematic state of every tank, helicopter and UFO in struct-of-arrays buffers
+ * and steps them all in one loop per frame, writing actor transforms back once.
+ * ATankAI, AHeliAI and AUFOAI register on BeginPlay and no longer tick themselves.
+ *
+ * The step only touches the entity's own slot (randomness comes from a per-entity stream),
+ * so it can run on worker threads via ParallelFor and still match the serial path exactly.
+ * Logging and timer scheduling are deferred to the game-thread commit. Fire, hover and
+ * lateral-leg countdowns live on UGameplayTimerSubsystem and only cost anything when they expire.
+ * Shots at the base are queued on UBaseDamageSubsystem.
+ * Committed positions are mirrored into UEnemySpatialGridSubsystem for neighborhood queries.
+ *
+ * Distant and off-screen enemies are stepped at 15 or 5 Hz with the accumulated time and
+ * extrapolated in between. Enemies close to a state change (arriving, starting to dance,
+ * reaching a waypoint) or driven by timers always step every frame, so arrival at the
+ * line of fire lands on the same frame as with full-rate stepping.
+ */
+UCLASS()
+class ZEGUNNER_API UEnemyMovementSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return !bPaused; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Add an enemy to the buffers, reading its current transform */
+	FEnemyHandle RegisterEnemy(APawn* Enemy, EEnemyType Type, const FEnemyMotionParams& InParams, float MoveSpeed);
+
+	/** Remove an enemy from the buffers and reset the handle */
+	void UnregisterEnemy(FEnemyHandle& Handle);
+
+	/** Actor behind a handle (nullptr if the handle is stale) */
+	APawn* GetActor(FEnemyHandle Handle) const;
+
+	/** Mutable movement configuration for an enemy (nullptr if the handle is stale) */
+	FEnemyMotionParams* GetParams(FEnemyHandle Handle);
+
+	/** Set movement speed (units/sec) */
+	void SetMoveSpeed(FEnemyHandle Handle, float NewSpeed);
+
+	/** Set the target and restart the type-specific maneuver (zigzag / waypoints) */
+	void SetTargetLocation(FEnemyHandle Handle, const FVector& NewTarget);
+
+	/** Rebuild a tank's route after its zigzag or stopping settings were changed */
+	void RebuildTankPath(FEnemyHandle Handle);
+
+	/** Re-read position and yaw from the actor after it was moved outside the subsystem */
+	void SyncFromActor(FEnemyHandle Handle);
+
+	/**
+	 * Where the enemy will be after the given number of seconds at its current speed.
+	 * Exact for tanks (read off the route); other types return their current position.
+	 */
+	FVector PredictLocation(FEnemyHandle Handle, float Seconds) const;
+
+	/** Whether the enemy is within its stopping distance of the target */
+	bool HasReachedTarget(FEnemyHandle Handle) const;
+
+	/** Number of registered enemies */
+	int32 GetNumEnemies() const { return Actors.Num(); }
+
+private:
+	/** Set while the game phase is Paused; the subsystem is not ticked at all */
+	bool bPaused = false;
+
+	UFUNCTION()
+	void HandlePhaseChanged(EGameState OldPhase, EGameState NewPhase);
+
+	UPROPERTY(Transient)
+	TObjectPtr<UGameplayTimerSubsystem> GameplayTimers;
+
+	/** Shared tank steering field, used to plan the straight run around obstacles */
+	UPROPERTY(Transient)
+	TObjectPtr<UEnemyFlowFieldSubsystem> FlowField;
+
+	/** Spatial index kept in sync with the committed positions */
+	UPROPERTY(Transient)
+	TObjectPtr<UEnemySpatialGridSubsystem> SpatialGrid;
+
+	// ==================== Struct-of-Arrays Buffers (dense, indexed together) ====================
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APawn>> Actors;
+
+	TArray<EEnemyType> Types;
+	TArray<FVector> Positions;
+	TArray<float> Yaws;
+	TArray<float> Speeds;
+
+	/** Next shot at the base while firing */
+	TArray<FGameplayTimerHandle> FireTimers;
+
+	/** Heli: end of the current lateral leg. UFO: end of the hover at the waypoint. */
+	TArray<FGameplayTimerHandle> ManeuverTimers;
+
+	TArray<EEnemyMotionFlags> Flags;
+	TArray<FEnemyTankPath> TankPaths;
+	TArray<FEnemyManeuver> Maneuvers;
+	TArray<FEnemyMotionParams> Params;
+
+	/** Per-entity random stream, seeded at registration so results don't depend on step order */
+	TArray<FRandomStream> RandomStreams;
+
+	/** Events raised during the step, consumed by ApplyStepEvents */
+	TArray<EEnemyStepEvents> StepEvents;
+
+	/** Dense index -> handle id, and handle id -> dense index (INDEX_NONE when free) */
+	TArray<int32> DenseToId;
+	TArray<int32> IdToDense;
+	TArray<int32> FreeIds;
+
+	/** Current serial of each handle id, bumped when the id is freed so old handles stop resolving */
+	TArray<uint32> IdSerials;
+
+	// ==================== Significance LOD ====================
+
+	/** Simulation time not yet stepped (the enemy is extrapolated across it) */
+	TArray<float> PendingStepTimes;
+
+	/** Velocity over the last step, used for extrapolation */
+	TArray<FVector> Velocities;
+
+	/** Turret camera for this frame's visibility test */
+	struct FSignificanceView
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Forward = FVector::ForwardVector;
+
+		/** Cosine of the half angle of a cone enclosing the view frustum */
+		float CosHalfAngle = -1.0f;
+
+		bool bValid = false;
+	};
+	FSignificanceView SignificanceView;
+
+	/** Number of enemies registered so far (seeds the random streams) */
+	int32 RegistrationCount = 0;
+
+	int32 ToDenseIndex(FEnemyHandle Handle) const;
+
+	/** Handle of the enemy at a dense index */
+	FEnemyHandle ToHandle(int32 Index) const { return FEnemyHandle{ DenseToId[Index], IdSerials[DenseToId[Index]] }; }
+
+	// ==================== Per-Type Steps ====================
+
+	/** Read the turret camera (zoomed FOV included) for the visibility part of the score */
+	void UpdateSignificanceView();
+
+	/** Score one enemy by distance to the base, visibility and state. Reads only slot Index. */
+	EEnemySignificance EvaluateSignificance(int32 Index) const;
+
+	/** Distance the enemy can travel before its next state change (arrival, dance ring, waypoint) */
+	float GetDistanceToNextTransition(int32 Index) const;
+
+	/** Step one enemy if its LOD interval elapsed. Must only write to slot Index (runs on worker threads). */
+	void StepEnemy(int32 Index, float DeltaTime);
+
+	void StepTank(int32 Index, float DeltaTime);
+	void StepHeli(int32 Index, float DeltaTime);
+	void StepUFO(int32 Index, float DeltaTime);
+
+	/** Flag the enemy as firing on arrival (the shots are timed on the game thread) */
+	void UpdateFiring(int32 Index, bool bAtLineOfFire);
+
+	// ==================== Timers (game thread) ====================
+
+	void ScheduleFireTimer(int32 Index);
+	void ScheduleManeuverTimer(int32 Index);
+	void OnFireTimer(FEnemyHandle Handle);
+	void OnManeuverTimer(FEnemyHandle Handle);
+
+	void BuildTankPath(int32 Index);
+	void PickNewLateralLeg(int32 Index);
+	void PickNewWaypoint(int32 Index);
+
+	/** Log step events in index order and count shots fired at the base */
+	void ApplyStepEvents();
+
+	/** Write the stepped transforms back to the actors and the spatial grid */
+	void CommitTransforms();
+};
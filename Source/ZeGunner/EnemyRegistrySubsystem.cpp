@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EnemyRegistrySubsystem.h"
+#include "GameFramework/Pawn.h"
+
+void UEnemyRegistrySubsystem::RegisterEnemy(APawn* Enemy, EEnemyType Type)
+{
+	if (!Enemy || Entries.Contains(Enemy))
+	{
+		return;
+	}
+
+	TArray<TObjectPtr<APawn>>& List = GetList(Type);
+	Entries.Add(Enemy, TPair<EEnemyType, int32>(Type, List.Add(Enemy)));
+}
+
+void UEnemyRegistrySubsystem::UnregisterEnemy(APawn* Enemy)
+{
+	TPair<EEnemyType, int32> Entry;
+	if (!Enemy || !Entries.RemoveAndCopyValue(Enemy, Entry))
+	{
+		return;
+	}
+
+	const EEnemyType Type = Entry.Key;
+	const int32 Index = Entry.Value;
+
+	// Swap the last enemy into the freed slot to keep the list contiguous
+	TArray<TObjectPtr<APawn>>& List = GetList(Type);
+	List.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (List.IsValidIndex(Index))
+	{
+		Entries[List[Index].Get()].Value = Index;
+	}
+}
+
+const TArray<TObjectPtr<APawn>>& UEnemyRegistrySubsystem::GetEnemies(EEnemyType Type) const
+{
+	switch (Type)
+	{
+	case EEnemyType::Heli:
+		return Helis;
+	case EEnemyType::UFO:
+		return UFOs;
+	default:
+		return Tanks;
+	}
+}
+
+bool UEnemyRegistrySubsystem::FindEnemyType(const APawn* Enemy, EEnemyType& OutType) const
+{
+	if (const TPair<EEnemyType, int32>* Entry = Entries.Find(Enemy))
+	{
+		OutType = Entry->Key;
+		return true;
+	}
+	return false;
+}
+
+TArray<TObjectPtr<APawn>>& UEnemyRegistrySubsystem::GetList(EEnemyType Type)
+{
+	return const_cast<TArray<TObjectPtr<APawn>>&>(static_cast<const UEnemyRegistrySubsystem*>(this)->GetEnemies(Type));
+}
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyTypes.h"
+#include "EnemyRegistrySubsystem.generated.h"
+
+class APawn;
+
+/**
+ * Live tanks, helicopters and UFOs, kept in one contiguous list per type.
+ * Enemies add themselves on BeginPlay and remove themselves on EndPlay, so radar,
+ * scoring and debug tools can walk just the live enemies instead of iterating the world.
+ */
+UCLASS()
+class ZEGUNNER_API UEnemyRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Add an enemy to its type's list */
+	void RegisterEnemy(APawn* Enemy, EEnemyType Type);
+
+	/** Remove an enemy from its list (deaths are announced by UEnemyKillSubsystem) */
+	void UnregisterEnemy(APawn* Enemy);
+
+	/** Live enemies of one type (order changes on removal) */
+	const TArray<TObjectPtr<APawn>>& GetEnemies(EEnemyType Type) const;
+
+	/** Type of a registered enemy; false when Enemy is not one */
+	bool FindEnemyType(const APawn* Enemy, EEnemyType& OutType) const;
+
+	/** Number of live enemies of one type */
+	int32 GetNumEnemies(EEnemyType Type) const { return GetEnemies(Type).Num(); }
+
+	/** Number of live enemies of all types */
+	int32 GetNumEnemies() const { return Tanks.Num() + Helis.Num() + UFOs.Num(); }
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APawn>> Tanks;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APawn>> Helis;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APawn>> UFOs;
+
+	/** Enemy -> type and index in its list, for O(1) removal */
+	TMap<const APawn*, TPair<EEnemyType, int32>> Entries;
+
+	TArray<TObjectPtr<APawn>>& GetList(EEnemyType Type);
+};
@@ -0,0 +1,279 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EnemySpatialGridSubsystem.h"
+#include "ZeGunner.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Grid Query"), STAT_EnemyGridQuery, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Grid Cells"), STAT_EnemyGridCells, STATGROUP_ZeGunner);
+
+bool UEnemySpatialGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ==================== Maintenance ====================
+
+void UEnemySpatialGridSubsystem::AddEnemy(FEnemyHandle Handle, EEnemyType Type, const FVector& Location)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	if (Handle.Id >= Entries.Num())
+	{
+		Entries.SetNum(Handle.Id + 1);
+	}
+	else if (IsTracked(Handle.Id))
+	{
+		RemoveFromCell(Handle.Id);
+		--NumEnemies;
+	}
+
+	FEntry& Entry = Entries[Handle.Id];
+	Entry.Location = Location;
+	Entry.Cell = ToCell(Location);
+	Entry.Type = Type;
+	Entry.Serial = Handle.Serial;
+	InsertIntoCell(Handle.Id);
+	++NumEnemies;
+}
+
+void UEnemySpatialGridSubsystem::RemoveEnemy(FEnemyHandle Handle)
+{
+	if (IsTracked(Handle))
+	{
+		RemoveFromCell(Handle.Id);
+		--NumEnemies;
+	}
+}
+
+void UEnemySpatialGridSubsystem::UpdateEnemy(FEnemyHandle Handle, const FVector& Location)
+{
+	if (!IsTracked(Handle))
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[Handle.Id];
+	Entry.Location = Location;
+
+	// Most moves stay inside the cell and cost nothing more than the store above
+	const FIntPoint NewCell = ToCell(Location);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(Handle.Id);
+		Entry.Cell = NewCell;
+		InsertIntoCell(Handle.Id);
+	}
+}
+
+FIntPoint UEnemySpatialGridSubsystem::ToCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UEnemySpatialGridSubsystem::InsertIntoCell(int32 Id)
+{
+	FEntry& Entry = Entries[Id];
+	TArray<int32>& Bucket = Cells.FindOrAdd(Entry.Cell);
+	Entry.SlotInCell = Bucket.Add(Id);
+
+	SET_DWORD_STAT(STAT_EnemyGridCells, Cells.Num());
+}
+
+void UEnemySpatialGridSubsystem::RemoveFromCell(int32 Id)
+{
+	FEntry& Entry = Entries[Id];
+	TArray<int32>& Bucket = Cells.FindChecked(Entry.Cell);
+
+	// Swap the last id into the freed slot and fix up its back-reference
+	const int32 Slot = Entry.SlotInCell;
+	Bucket.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	if (Bucket.IsValidIndex(Slot))
+	{
+		Entries[Bucket[Slot]].SlotInCell = Slot;
+	}
+
+	Entry.SlotInCell = INDEX_NONE;
+}
+
+FVector UEnemySpatialGridSubsystem::GetLocation(FEnemyHandle Handle) const
+{
+	return IsTracked(Handle) ? Entries[Handle.Id].Location : FVector::ZeroVector;
+}
+
+// ==================== Queries ====================
+
+template <typename VisitorType>
+void UEnemySpatialGridSubsystem::ForEachInBox(const FVector2D& Min, const FVector2D& Max, uint8 TypeMask, VisitorType&& Visit) const
+{
+	const FIntPoint MinCell = ToCell(FVector(Min, 0.0));
+	const FIntPoint MaxCell = ToCell(FVector(Max, 0.0));
+	const int64 NumBoxCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+	auto VisitBucket = [this, TypeMask, &Visit](const TArray<int32>& Bucket)
+	{
+		for (const int32 Id : Bucket)
+		{
+			if (TypeMask & EnemyTypeBit(Entries[Id].Type))
+			{
+				Visit(Id);
+			}
+		}
+	};
+
+	// A huge box is cheaper to answer from the occupied buckets
+	if (NumBoxCells > Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Pair : Cells)
+		{
+			if (Pair.Key.X >= MinCell.X && Pair.Key.X <= MaxCell.X && Pair.Key.Y >= MinCell.Y && Pair.Key.Y <= MaxCell.Y)
+			{
+				VisitBucket(Pair.Value);
+			}
+		}
+		return;
+	}
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			if (const TArray<int32>* Bucket = Cells.Find(FIntPoint(X, Y)))
+			{
+				VisitBucket(*Bucket);
+			}
+		}
+	}
+}
+
+void UEnemySpatialGridSubsystem::QueryRadius(const FVector& Center, float Radius, TArray<FEnemyHandle>& OutHandles, uint8 TypeMask) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyGridQuery);
+
+	const FVector2D Center2D(Center);
+	const double RadiusSquared = FMath::Square(Radius);
+
+	ForEachInBox(Center2D - FVector2D(Radius), Center2D + FVector2D(Radius), TypeMask, [&](int32 Id)
+	{
+		if (FVector::DistSquared(Entries[Id].Location, Center) <= RadiusSquared)
+		{
+			OutHandles.Add(ToHandle(Id));
+		}
+	});
+}
+
+void UEnemySpatialGridSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float MaxDistance, TArray<FEnemyHandle>& OutHandles, uint8 TypeMask) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyGridQuery);
+
+	const FVector2D Origin2D(Origin);
+	const double MaxDistanceSquared = FMath::Square(MaxDistance);
+	const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+
+	ForEachInBox(Origin2D - FVector2D(MaxDistance), Origin2D + FVector2D(MaxDistance), TypeMask, [&](int32 Id)
+	{
+		const FVector ToEnemy = Entries[Id].Location - Origin;
+		const double DistanceSquared = ToEnemy.SizeSquared();
+		if (DistanceSquared > MaxDistanceSquared)
+		{
+			return;
+		}
+
+		// Inside when the angle to the axis is within the half angle
+		const double Along = FVector::DotProduct(ToEnemy, Direction);
+		if (Along >= CosHalfAngle * FMath::Sqrt(DistanceSquared))
+		{
+			OutHandles.Add(ToHandle(Id));
+		}
+	});
+}
+
+void UEnemySpatialGridSubsystem::QuerySegment(const FVector& Start, const FVector& End, float Radius, TArray<FEnemyHandle>& OutHandles, TArray<float>* OutDistances, uint8 TypeMask) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyGridQuery);
+
+	const FVector Segment = End - Start;
+	const double Length = Segment.Size();
+	const FVector Direction = Length > UE_SMALL_NUMBER ? Segment / Length : FVector::ZeroVector;
+	const double RadiusSquared = FMath::Square(Radius);
+
+	struct FSegmentHit
+	{
+		int32 Id;
+		double Distance;
+	};
+	TArray<FSegmentHit, TInlineAllocator<16>> Hits;
+
+	// Walk the cells the radius-inflated segment covers one row at a time; each row's span of
+	// columns comes from where the segment crosses that row, so every cell is visited once
+	const FVector2D Start2D(Start);
+	const FVector2D Delta2D(Segment);
+	const int32 MinRow = ToCell(FVector(FVector2D::Min(Start2D, Start2D + Delta2D) - FVector2D(Radius), 0.0)).Y;
+	const int32 MaxRow = ToCell(FVector(FVector2D::Max(Start2D, Start2D + Delta2D) + FVector2D(Radius), 0.0)).Y;
+
+	for (int32 Y = MinRow; Y <= MaxRow; ++Y)
+	{
+		// Part of the segment within Radius of this row, as a fraction of its length
+		double T0 = 0.0;
+		double T1 = 1.0;
+		if (!FMath::IsNearlyZero(Delta2D.Y))
+		{
+			const double RowMin = double(Y) * CellSize - Radius;
+			const double RowMax = double(Y + 1) * CellSize + Radius;
+			T0 = (RowMin - Start2D.Y) / Delta2D.Y;
+			T1 = (RowMax - Start2D.Y) / Delta2D.Y;
+			if (T0 > T1)
+			{
+				Swap(T0, T1);
+			}
+			T0 = FMath::Max(T0, 0.0);
+			T1 = FMath::Min(T1, 1.0);
+			if (T0 > T1)
+			{
+				continue;
+			}
+		}
+
+		const double SpanX0 = Start2D.X + Delta2D.X * T0;
+		const double SpanX1 = Start2D.X + Delta2D.X * T1;
+		const int32 MinColumn = FMath::FloorToInt32((FMath::Min(SpanX0, SpanX1) - Radius) / CellSize);
+		const int32 MaxColumn = FMath::FloorToInt32((FMath::Max(SpanX0, SpanX1) + Radius) / CellSize);
+
+		for (int32 X = MinColumn; X <= MaxColumn; ++X)
+		{
+			const TArray<int32>* Bucket = Cells.Find(FIntPoint(X, Y));
+			if (!Bucket)
+			{
+				continue;
+			}
+
+			for (const int32 Id : *Bucket)
+			{
+				const FEntry& Entry = Entries[Id];
+				if (!(TypeMask & EnemyTypeBit(Entry.Type)))
+				{
+					continue;
+				}
+
+				const double Along = FMath::Clamp(FVector::DotProduct(Entry.Location - Start, Direction), 0.0, Length);
+				if (FVector::DistSquared(Start + Direction * Along, Entry.Location) <= RadiusSquared)
+				{
+					Hits.Add({ Id, Along });
+				}
+			}
+		}
+	}
+
+	Hits.Sort([](const FSegmentHit& A, const FSegmentHit& B) { return A.Distance < B.Distance; });
+
+	for (const FSegmentHit& Hit : Hits)
+	{
+		OutHandles.Add(ToHandle(Hit.Id));
+		if (OutDistances)
+		{
+			OutDistances->Add(static_cast<float>(Hit.Distance));
+		}
+	}
+}
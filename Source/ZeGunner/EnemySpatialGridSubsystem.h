@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyTypes.h"
+#include "EnemySpatialGridSubsystem.generated.h"
+
+/**
+ * Uniform spatial hash over live enemy positions (XY cells, full 3D tests).
+ * UEnemyMovementSubsystem keeps it current: enemies are added on registration and only
+ * change buckets when a committed move crosses a cell border.
+ * Queries return movement handles without touching the physics scene, so splash damage
+ * and aiming scale with the enemies near the query rather than with the world.
+ * Game thread only.
+ */
+UCLASS()
+class ZEGUNNER_API UEnemySpatialGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ==================== Maintenance (called by UEnemyMovementSubsystem) ====================
+
+	void AddEnemy(FEnemyHandle Handle, EEnemyType Type, const FVector& Location);
+	void RemoveEnemy(FEnemyHandle Handle);
+	void UpdateEnemy(FEnemyHandle Handle, const FVector& Location);
+
+	// ==================== Queries ====================
+
+	/** Enemies within Radius of Center */
+	void QueryRadius(const FVector& Center, float Radius, TArray<FEnemyHandle>& OutHandles, uint8 TypeMask = AllEnemyTypesMask) const;
+
+	/**
+	 * Enemies inside a view cone.
+	 * @param Direction - Cone axis (normalized)
+	 * @param HalfAngleDegrees - Angle between the axis and the cone's edge
+	 */
+	void QueryCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float MaxDistance, TArray<FEnemyHandle>& OutHandles, uint8 TypeMask = AllEnemyTypesMask) const;
+
+	/**
+	 * Enemies within Radius of the segment, nearest to Start first.
+	 * @param OutDistances - Optional, distance along the segment of each returned enemy
+	 */
+	void QuerySegment(const FVector& Start, const FVector& End, float Radius, TArray<FEnemyHandle>& OutHandles, TArray<float>* OutDistances = nullptr, uint8 TypeMask = AllEnemyTypesMask) const;
+
+	/** Last location the grid saw for an enemy */
+	FVector GetLocation(FEnemyHandle Handle) const;
+
+	/** Number of enemies in the grid */
+	int32 GetNumEnemies() const { return NumEnemies; }
+
+private:
+	/** Edge length of a cell; about the spread of a splash radius */
+	static constexpr float CellSize = 1000.0f;
+
+	struct FEntry
+	{
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+
+		/** Position in the cell's bucket (INDEX_NONE when the id is free) */
+		int32 SlotInCell = INDEX_NONE;
+
+		EEnemyType Type = EEnemyType::Tank;
+
+		/** Serial of the handle that added the entry; queries hand it back out */
+		uint32 Serial = 0;
+	};
+
+	/** Indexed by handle id */
+	TArray<FEntry> Entries;
+
+	/** Cell -> handle ids inside it. Empty buckets are kept for reuse. */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	int32 NumEnemies = 0;
+
+	static FIntPoint ToCell(const FVector& Location);
+
+	bool IsTracked(int32 Id) const { return Entries.IsValidIndex(Id) && Entries[Id].SlotInCell != INDEX_NONE; }
+
+	/** Tracked, and under the same serial as Handle (not a recycled slot) */
+	bool IsTracked(FEnemyHandle Handle) const { return IsTracked(Handle.Id) && Entries[Handle.Id].Serial == Handle.Serial; }
+
+	FEnemyHandle ToHandle(int32 Id) const { return FEnemyHandle{ Id, Entries[Id].Serial }; }
+
+	void InsertIntoCell(int32 Id);
+	void RemoveFromCell(int32 Id);
+
+	/**
+	 * Call Visit(Id) for every entry in cells overlapping the XY box.
+	 * Falls back to walking the occupied buckets when the box covers more cells than exist.
+	 */
+	template <typename VisitorType>
+	void ForEachInBox(const FVector2D& Min, const FVector2D& Max, uint8 TypeMask, VisitorType&& Visit) const;
+};
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyTypes.generated.h"
+
+/** Kind of enemy, used by the shared enemy systems to pick per-type behavior */
+UENUM(BlueprintType)
+enum class EEnemyType : uint8
+{
+	Tank,
+	Heli,
+	UFO
+};
+
+/** Number of EEnemyType values, for per-type arrays */
+constexpr int32 NumEnemyTypes = 3;
+
+/** Bit for one type in an enemy type mask */
+constexpr uint8 EnemyTypeBit(EEnemyType Type) { return uint8(1) << static_cast<uint8>(Type); }
+
+/** Mask matching every enemy type */
+constexpr uint8 AllEnemyTypesMask = (1 << NumEnemyTypes) - 1;
+
+/**
+ * Stable handle to an enemy slot owned by UEnemyMovementSubsystem.
+ * Stays valid while the enemy is registered, even when the dense buffers are compacted.
+ * Slots are recycled; the serial changes on every reuse, so a handle kept past its enemy's
+ * unregistration (a pending hit, last frame's query result) resolves to nothing instead of
+ * to whichever enemy took the slot next.
+ */
+struct FEnemyHandle
+{
+	int32 Id = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Id != INDEX_NONE; }
+	void Reset() { Id = INDEX_NONE; Serial = 0; }
+
+	bool operator==(const FEnemyHandle& Other) const { return Id == Other.Id && Serial == Other.Serial; }
+	bool operator!=(const FEnemyHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FEnemyHandle& Handle) { return HashCombine(::GetTypeHash(Handle.Id), ::GetTypeHash(Handle.Serial)); }
+};
@@ -0,0 +1,178 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ExplosionBatchSubsystem.h"
+#include "ExplosionTypes.h"
+#include "ZeGunner.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Explosion Batch Push"), STAT_ExplosionBatchPush, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Explosion Events"), STAT_BatchedExplosionEvents, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Explosion Systems"), STAT_BatchedExplosionSystems, STATGROUP_ZeGunner);
+
+namespace ExplosionBatchParams
+{
+	static const FName Positions(TEXT("ExplosionPositions"));
+	static const FName Scales(TEXT("ExplosionScales"));
+	static const FName Rotations(TEXT("ExplosionRotations"));
+	static const FName Count(TEXT("ExplosionCount"));
+}
+
+bool UExplosionBatchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UExplosionBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExplosionBatchSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Events ====================
+
+bool UExplosionBatchSubsystem::AddExplosion(const FVector& Location, const FExplosionConfig& Config)
+{
+	if (!Config.BatchedNiagaraSystem)
+	{
+		return false;
+	}
+
+	const int32 Index = FindOrCreateBatch(Config.BatchedNiagaraSystem);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FVector FinalLocation = Location + Config.LocationOffset;
+
+	FExplosionEventBuffer& Buffer = EventBuffers[Index];
+	Buffer.Positions.Add(FinalLocation);
+	Buffer.Scales.Add(Config.ExplosionScale);
+	Buffer.Rotations.Add(Config.bRandomRotation ? FMath::FRandRange(0.0f, 360.0f) : 0.0f);
+
+	// A wave of kills would otherwise stack dozens of identical one-shots on the same frame
+	if (Config.ExplosionSound)
+	{
+		if (!Buffer.Sound)
+		{
+			Buffer.Sound = Config.ExplosionSound;
+		}
+		Buffer.SoundVolume = FMath::Max(Buffer.SoundVolume, Config.SoundVolume);
+	}
+
+	return true;
+}
+
+void UExplosionBatchSubsystem::Prewarm(UNiagaraSystem* System)
+{
+	if (System)
+	{
+		FindOrCreateBatch(System);
+	}
+}
+
+int32 UExplosionBatchSubsystem::FindOrCreateBatch(UNiagaraSystem* System)
+{
+	// A level uses a handful of explosion types, so a linear scan is all this needs
+	for (int32 Index = 0; Index < BatchComponents.Num(); ++Index)
+	{
+		if (BatchComponents[Index] && BatchComponents[Index]->GetAsset() == System)
+		{
+			return Index;
+		}
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return INDEX_NONE;
+	}
+
+	if (!BatchActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		BatchActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!BatchActor)
+		{
+			return INDEX_NONE;
+		}
+	}
+
+	UNiagaraComponent* Component = NewObject<UNiagaraComponent>(BatchActor);
+	Component->SetAutoDestroy(false);
+	Component->SetAutoActivate(false);
+	Component->SetAsset(System);
+	Component->SetSystemFixedBounds(FBox(FVector(-BatchBoundsExtent), FVector(BatchBoundsExtent)));
+	Component->RegisterComponent();
+	Component->SetVariableInt(ExplosionBatchParams::Count, 0);
+	Component->Activate(true);
+
+	UE_LOG(LogTemp, Log, TEXT("ExplosionBatch: Created batched component for %s"), *System->GetName());
+
+	EventBuffers.AddDefaulted();
+	const int32 Index = BatchComponents.Add(Component);
+	SET_DWORD_STAT(STAT_BatchedExplosionSystems, BatchComponents.Num());
+	return Index;
+}
+
+// ==================== Tick ====================
+
+void UExplosionBatchSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_ExplosionBatchPush);
+
+	int32 NumEvents = 0;
+	for (int32 Index = 0; Index < BatchComponents.Num(); ++Index)
+	{
+		NumEvents += EventBuffers[Index].Num();
+		PushEvents(Index);
+	}
+
+	SET_DWORD_STAT(STAT_BatchedExplosionEvents, NumEvents);
+}
+
+void UExplosionBatchSubsystem::PushEvents(int32 Index)
+{
+	UNiagaraComponent* Component = BatchComponents[Index];
+	FExplosionEventBuffer& Buffer = EventBuffers[Index];
+	if (!IsValid(Component))
+	{
+		Buffer.Reset();
+		return;
+	}
+
+	if (Buffer.Num() == 0)
+	{
+		// Stop last frame's explosions from spawning again
+		if (Buffer.bPushedLastFrame)
+		{
+			Component->SetVariableInt(ExplosionBatchParams::Count, 0);
+			Buffer.bPushedLastFrame = false;
+		}
+		return;
+	}
+
+	if (Buffer.Sound)
+	{
+		FVector Center = FVector::ZeroVector;
+		for (const FVector& Position : Buffer.Positions)
+		{
+			Center += Position;
+		}
+		UGameplayStatics::PlaySoundAtLocation(this, Buffer.Sound, Center / Buffer.Num(), Buffer.SoundVolume);
+	}
+
+	UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(Component, ExplosionBatchParams::Positions, Buffer.Positions);
+	UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(Component, ExplosionBatchParams::Scales, Buffer.Scales);
+	UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(Component, ExplosionBatchParams::Rotations, Buffer.Rotations);
+	Component->SetVariableInt(ExplosionBatchParams::Count, Buffer.Num());
+
+	Buffer.bPushedLastFrame = true;
+	Buffer.Reset();
+}
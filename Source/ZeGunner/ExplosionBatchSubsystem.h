@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExplosionBatchSubsystem.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+class USoundBase;
+struct FExplosionConfig;
+
+/** Explosions for one batched system waiting to be pushed, one entry per explosion */
+struct FExplosionEventBuffer
+{
+	TArray<FVector> Positions;
+	TArray<float> Scales;
+
+	/** Yaw in degrees (0 when the config has random rotation off) */
+	TArray<float> Rotations;
+
+	/** Sound of the first explosion this frame with one, played once for the whole buffer */
+	USoundBase* Sound = nullptr;
+	float SoundVolume = 0.0f;
+
+	/** Last push was non-empty, so the count has to be cleared next frame */
+	bool bPushedLastFrame = false;
+
+	int32 Num() const { return Positions.Num(); }
+
+	void Reset()
+	{
+		Positions.Reset();
+		Scales.Reset();
+		Rotations.Reset();
+		Sound = nullptr;
+		SoundVolume = 0.0f;
+	}
+};
+
+/**
+ * Draws explosions whose config names a BatchedNiagaraSystem through one persistent Niagara
+ * component per system instead of an explosion actor each. Explosions are appended to an event
+ * buffer; once per frame the buffer is written to the component's array user parameters, so a
+ * frame with fifty kills costs fifty array appends and one parameter upload. The sound is
+ * batched the same way: one per system per frame, at the middle of that frame's explosions.
+ *
+ * Contract for the batched Niagara system (world-space emitters, no loop end):
+ *   User.ExplosionPositions (Vector Array)  - world position of each new explosion
+ *   User.ExplosionScales    (Float Array)   - FExplosionConfig::ExplosionScale of each
+ *   User.ExplosionRotations (Float Array)   - yaw in degrees of each
+ *   User.ExplosionCount     (Int)           - number of new explosions, 0 on frames without any
+ * Each frame the emitter spawns ExplosionCount particles and reads its entry by spawn index.
+ */
+UCLASS()
+class ZEGUNNER_API UExplosionBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return BatchComponents.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Queue an explosion with its config's batched system; its sound joins the frame's one sound for that system.
+	 * Returns false, doing nothing, when the config has no BatchedNiagaraSystem.
+	 */
+	bool AddExplosion(const FVector& Location, const FExplosionConfig& Config);
+
+	/** Create the persistent component for a batched system up front, so the first kill doesn't pay for it */
+	void Prewarm(UNiagaraSystem* System);
+
+private:
+	/** Half size of the fixed bounds given to every batched component (they never cull as a whole) */
+	static constexpr double BatchBoundsExtent = 200000.0;
+
+	/** Owner of every batched component */
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> BatchActor;
+
+	/** One always-active component per batched system */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UNiagaraComponent>> BatchComponents;
+
+	/** Pending events, indexed with BatchComponents */
+	TArray<FExplosionEventBuffer> EventBuffers;
+
+	/** Index of the component for System, creating it if needed (INDEX_NONE on failure) */
+	int32 FindOrCreateBatch(UNiagaraSystem* System);
+
+	/** Write a buffer to its component's user parameters and empty it */
+	void PushEvents(int32 Index);
+};
@@ -2,9 +2,14 @@
 
 #include "ExplosionComponent.h"
 #include "ExplosionEffect.h"
-#include "FighterPawn.h"
-#include "Kismet/GameplayStatics.h"
-#include "GameFramework/PlayerController.h"
+#include "ExplosionSchedulerSubsystem.h"
+#include "ExplosionConfigAsset.h"
+#include "WeaponAudioSubsystem.h"
+#include "ZeGunner.h"
+
+DECLARE_MEMORY_STAT(TEXT("Inline Explosion Configs"), STAT_InlineExplosionConfigMemory, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shared Explosion Config Users"), STAT_SharedExplosionConfigUsers, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Config Copies"), STAT_ExplosionConfigCopies, STATGROUP_ZeGunner);
 
 UExplosionComponent::UExplosionComponent()
 {
@@ -14,48 +19,67 @@ UExplosionComponent::UExplosionComponent()
 void UExplosionComponent::BeginPlay()
 {
     Super::BeginPlay();
+
+    // Memory that moving this enemy onto a shared config asset would save
+    if (ConfigAsset)
+    {
+        INC_DWORD_STAT(STAT_SharedExplosionConfigUsers);
+    }
+    else
+    {
+        INC_MEMORY_STAT_BY(STAT_InlineExplosionConfigMemory, sizeof(FExplosionConfig));
+    }
 }
 
-float UExplosionComponent::GetSoundVolume() const
+void UExplosionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    // First try to get volume from owner if it's a FighterPawn
-    if (AFighterPawn* Fighter = Cast<AFighterPawn>(GetOwner()))
+    if (ConfigAsset)
+    {
+        DEC_DWORD_STAT(STAT_SharedExplosionConfigUsers);
+    }
+    else
     {
-        UE_LOG(LogTemp, Log, TEXT("ExplosionComponent: Got volume %.2f from FighterPawn owner"), Fighter->GetSoundVolume());
-        return Fighter->GetSoundVolume();
+        DEC_MEMORY_STAT_BY(STAT_InlineExplosionConfigMemory, sizeof(FExplosionConfig));
     }
-    
-    // If owner is not a FighterPawn, try to find the player's FighterPawn in the world
-    if (GetWorld())
+
+    Super::EndPlay(EndPlayReason);
+}
+
+const FExplosionConfig& UExplosionComponent::GetExplosionConfig() const
+{
+    return ConfigAsset ? ConfigAsset->Config : ExplosionConfig;
+}
+
+float UExplosionComponent::GetSoundVolume() const
+{
+    // The player's volume setting, cached by the weapon audio subsystem
+    if (const UWeaponAudioSubsystem* WeaponAudio = GetWorld() ? GetWorld()->GetSubsystem<UWeaponAudioSubsystem>() : nullptr)
     {
-        for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
-        {
-            if (APlayerController* PC = It->Get())
-            {
-                if (AFighterPawn* Fighter = Cast<AFighterPawn>(PC->GetPawn()))
-                {
-                    UE_LOG(LogTemp, Log, TEXT("ExplosionComponent: Got volume %.2f from world FighterPawn"), Fighter->GetSoundVolume());
-                    return Fighter->GetSoundVolume();
-                }
-            }
-        }
+        return WeaponAudio->GetVolume();
     }
-    
-    // Default volume if no FighterPawn found
-    UE_LOG(LogTemp, Log, TEXT("ExplosionComponent: No FighterPawn found, using default volume 1.0"));
     return 1.0f;
 }
 
 void UExplosionComponent::SpawnExplosion(const FVector& Location, const FVector& Normal)
 {
-    FExplosionConfig Config = ExplosionConfig;
-    Config.SoundVolume = GetSoundVolume();
-    
+    const FExplosionConfig& Config = GetExplosionConfig();
+    const float SoundVolume = GetSoundVolume();
+
     UE_LOG(LogTemp, Log, TEXT("ExplosionComponent: Spawning explosion with sound %s at volume %.2f"), 
         Config.ExplosionSound ? *Config.ExplosionSound->GetName() : TEXT("None"), 
-        Config.SoundVolume);
-    
-    AExplosionEffect::SpawnExplosion(this, Location, Config, Normal);
+        SoundVolume);
+
+    // A shared config is queued by reference; the scheduler copies it once per merged explosion
+    UExplosionSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UExplosionSchedulerSubsystem>() : nullptr;
+    if (ConfigAsset && Scheduler)
+    {
+        Scheduler->RequestExplosion(Location, *ConfigAsset, SoundVolume, Normal);
+        return;
+    }
+
+    FExplosionConfig VolumeConfig = Config;
+    VolumeConfig.SoundVolume = SoundVolume;
+    SpawnConfiguredExplosion(Location, VolumeConfig, Normal);
 }
 
 void UExplosionComponent::SpawnExplosionAtOwner()
@@ -80,6 +104,20 @@ void UExplosionComponent::SpawnExplosionSimple(UParticleSystem* ParticleSystem,
 
     if (GetOwner())
     {
-        AExplosionEffect::SpawnExplosion(this, GetOwner()->GetActorLocation(), Config);
+        SpawnConfiguredExplosion(GetOwner()->GetActorLocation(), Config, FVector::UpVector);
     }
 }
+
+void UExplosionComponent::SpawnConfiguredExplosion(const FVector& Location, const FExplosionConfig& Config, const FVector& Normal) const
+{
+    INC_DWORD_STAT(STAT_ExplosionConfigCopies);
+
+    // Same-frame blasts are merged and budgeted by the scheduler when the world has one
+    if (UExplosionSchedulerSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UExplosionSchedulerSubsystem>() : nullptr)
+    {
+        Scheduler->RequestExplosion(Location, Config, Normal);
+        return;
+    }
+
+    AExplosionEffect::SpawnExplosion(GetWorld(), Location, Config, Normal);
+}
@@ -8,6 +8,8 @@
 #include "NiagaraSystem.h"
 #include "ExplosionComponent.generated.h"
 
+class UExplosionConfigAsset;
+
 /**
  * Explosion component that can be attached to projectiles.
  * Allows easy configuration of explosion effects without modifying projectile code.
@@ -41,13 +43,32 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Explosion")
     void SpawnExplosionSimple(UParticleSystem* ParticleSystem, UNiagaraSystem* NiagaraSystem = nullptr, float Scale = 1.0f);
 
-    /** The explosion configuration to use when spawning */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion Config")
+    /**
+     * Shared explosion type to spawn; every enemy of a kind points at the same asset.
+     * Set on the class defaults only: the shared-config stats are counted at BeginPlay and EndPlay
+     * and assume it doesn't change in between.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Explosion Config")
+    TObjectPtr<UExplosionConfigAsset> ConfigAsset;
+
+    /**
+     * DEPRECATED: only read while Config Asset is empty, so enemy Blueprints set up before shared
+     * assets still explode. To migrate, create an Explosion Config Asset, copy these settings into
+     * its Config, assign it to Config Asset, and reset this to defaults.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion Config|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Move these settings into an Explosion Config Asset and assign it to Config Asset."))
     FExplosionConfig ExplosionConfig;
 
+    /** The config this component spawns: the shared asset's, or the deprecated inline one without an asset */
+    const FExplosionConfig& GetExplosionConfig() const;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     
-    /** Get sound volume from player FighterPawn, with fallback to default */
+    /** Player sound volume (cached by the weapon audio subsystem), 1.0 if unavailable */
     float GetSoundVolume() const;
+
+    /** Hand the explosion to the explosion scheduler, or spawn it directly if there is none */
+    void SpawnConfiguredExplosion(const FVector& Location, const FExplosionConfig& Config, const FVector& Normal) const;
 };
@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ExplosionTypes.h"
+#include "ExplosionConfigAsset.generated.h"
+
+/**
+ * One explosion type shared by every enemy that uses it.
+ * Explosion components point at an asset instead of each holding their own FExplosionConfig,
+ * and explosions are queued with a reference to it rather than a copy.
+ */
+UCLASS(BlueprintType)
+class ZEGUNNER_API UExplosionConfigAsset : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** The explosion this asset describes */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Explosion")
+    FExplosionConfig Config;
+};
@@ -1,10 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ExplosionEffect.h"
+#include "ExplosionPoolSubsystem.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Components/AudioComponent.h"
 #include "Components/DecalComponent.h"
+#include "Components/MaterialBillboardComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "GameFramework/PlayerController.h"
@@ -30,6 +33,12 @@ AExplosionEffect::AExplosionEffect()
     NiagaraComponent->bAutoActivate = false;
     NiagaraComponent->SetVisibleFlag(false); // Hide until valid asset is set
 
+    // Create billboard component (for the flipbook LOD tier)
+    BillboardComponent = CreateDefaultSubobject<UMaterialBillboardComponent>(TEXT("BillboardComponent"));
+    BillboardComponent->SetupAttachment(RootComponent);
+    BillboardComponent->SetVisibleFlag(false); // Hide until a billboard material is set
+    BillboardMaterialInstance = nullptr;
+
     // Create audio component
     AudioComponent = CreateDefaultSubobject<UAudioComponent>(TEXT("AudioComponent"));
     AudioComponent->SetupAttachment(RootComponent);
@@ -46,7 +55,8 @@ void AExplosionEffect::BeginPlay()
 {
     Super::BeginPlay();
 
-    if (!bIsInitialized)
+    // Pooled instances start dormant and are armed by InitializeExplosion
+    if (!bIsInitialized && !OwningPool.IsValid())
     {
         ApplyConfiguration();
     }
@@ -61,6 +71,11 @@ void AExplosionEffect::InitializeExplosion(const FExplosionConfig& Config)
 {
     CurrentConfig = Config;
     bIsInitialized = true;
+
+    // Re-arm a dormant pooled instance (a no-op for a freshly spawned one)
+    GetWorldTimerManager().ClearTimer(CleanupTimerHandle);
+    SetActorHiddenInGame(false);
+
     ApplyConfiguration();
 }
 
@@ -78,15 +93,12 @@ AExplosionEffect* AExplosionEffect::SpawnExplosion(UObject* WorldContext, const
     }
 
     // Only spawn if there's something to show (prevent empty actor with debug visuals)
-    if (!Config.ParticleSystem && !Config.NiagaraSystem && !Config.ExplosionSound && !Config.DecalMaterial)
+    if (!Config.ParticleSystem && !Config.NiagaraSystem && !Config.BillboardMaterial && !Config.ExplosionSound && !Config.DecalMaterial)
     {
         UE_LOG(LogTemp, Log, TEXT("ExplosionEffect: No effect configured, skipping spawn"));
         return nullptr;
     }
 
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
     // Calculate rotation - add random rotation if enabled
     FRotator SpawnRotation = FRotator::ZeroRotator;
     if (Config.bRandomRotation)
@@ -97,11 +109,27 @@ AExplosionEffect* AExplosionEffect::SpawnExplosion(UObject* WorldContext, const
     // Apply location offset
     FVector FinalLocation = Location + Config.LocationOffset;
 
-    AExplosionEffect* Explosion = World->SpawnActor<AExplosionEffect>(
-        AExplosionEffect::StaticClass(),
-        FinalLocation,
-        SpawnRotation,
-        SpawnParams);
+    // Reuse a dormant explosion when the world has a pool, otherwise spawn a standalone one
+    AExplosionEffect* Explosion = nullptr;
+    if (UExplosionPoolSubsystem* Pool = World->GetSubsystem<UExplosionPoolSubsystem>())
+    {
+        Explosion = Pool->Acquire();
+        if (Explosion)
+        {
+            Explosion->SetActorLocationAndRotation(FinalLocation, SpawnRotation, false, nullptr, ETeleportType::TeleportPhysics);
+        }
+    }
+    else
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        Explosion = World->SpawnActor<AExplosionEffect>(
+            AExplosionEffect::StaticClass(),
+            FinalLocation,
+            SpawnRotation,
+            SpawnParams);
+    }
 
     if (Explosion)
     {
@@ -141,6 +169,10 @@ void AExplosionEffect::ApplyConfiguration()
     {
         SpawnParticleEffect();
     }
+    else if (CurrentConfig.BillboardMaterial)
+    {
+        SpawnBillboardEffect();
+    }
 
     // Play sound
     if (CurrentConfig.ExplosionSound)
@@ -157,8 +189,15 @@ void AExplosionEffect::ApplyConfiguration()
         ApplyCameraShake();
     }
 
-    // Set cleanup timer
-    SetLifeSpan(CurrentConfig.LifeSpan);
+    // Set cleanup timer (pooled instances must always come back, so they get one even with no lifespan)
+    if (OwningPool.IsValid())
+    {
+        GetWorldTimerManager().SetTimer(CleanupTimerHandle, this, &AExplosionEffect::CleanupExplosion, FMath::Max(CurrentConfig.LifeSpan, 0.1f), false);
+    }
+    else
+    {
+        SetLifeSpan(CurrentConfig.LifeSpan);
+    }
 }
 
 void AExplosionEffect::SpawnParticleEffect()
@@ -168,7 +207,11 @@ void AExplosionEffect::SpawnParticleEffect()
         return;
     }
 
-    ParticleComponent->SetTemplate(CurrentConfig.ParticleSystem);
+    // A re-armed instance usually plays the same asset again; only swap templates when it changed
+    if (ParticleComponent->Template != CurrentConfig.ParticleSystem)
+    {
+        ParticleComponent->SetTemplate(CurrentConfig.ParticleSystem);
+    }
     ParticleComponent->SetVisibleFlag(true);
     ParticleComponent->ActivateSystem(true);
 }
@@ -180,11 +223,38 @@ void AExplosionEffect::SpawnNiagaraEffect()
         return;
     }
 
-    NiagaraComponent->SetAsset(CurrentConfig.NiagaraSystem);
+    if (NiagaraComponent->GetAsset() != CurrentConfig.NiagaraSystem)
+    {
+        NiagaraComponent->SetAsset(CurrentConfig.NiagaraSystem);
+    }
     NiagaraComponent->SetVisibleFlag(true);
     NiagaraComponent->Activate(true);
 }
 
+void AExplosionEffect::SpawnBillboardEffect()
+{
+    if (!CurrentConfig.BillboardMaterial)
+    {
+        return;
+    }
+
+    if (!BillboardMaterialInstance || BillboardMaterialInstance->Parent != CurrentConfig.BillboardMaterial)
+    {
+        BillboardMaterialInstance = UMaterialInstanceDynamic::Create(CurrentConfig.BillboardMaterial, this);
+    }
+
+    // The flipbook plays from StartTime, so a re-armed billboard starts from its first frame
+    BillboardMaterialInstance->SetScalarParameterValue(TEXT("StartTime"), GetWorld()->GetTimeSeconds());
+
+    FMaterialSpriteElement Element;
+    Element.Material = BillboardMaterialInstance;
+    Element.bSizeIsInScreenSpace = false;
+    Element.BaseSizeX = CurrentConfig.BillboardSize;
+    Element.BaseSizeY = CurrentConfig.BillboardSize;
+    BillboardComponent->SetVisibleFlag(true);
+    BillboardComponent->SetElements({ Element }); // Rebuilds the render state with the flag above
+}
+
 void AExplosionEffect::PlayExplosionSound()
 {
     if (!CurrentConfig.ExplosionSound)
@@ -259,5 +329,27 @@ void AExplosionEffect::ApplyCameraShake()
 
 void AExplosionEffect::CleanupExplosion()
 {
+    if (UExplosionPoolSubsystem* Pool = OwningPool.Get())
+    {
+        Pool->Release(this);
+        return;
+    }
+
     Destroy();
 }
+
+void AExplosionEffect::ReturnToPool()
+{
+    GetWorldTimerManager().ClearTimer(CleanupTimerHandle);
+
+    ParticleComponent->DeactivateImmediate();
+    ParticleComponent->SetVisibleFlag(false);
+
+    NiagaraComponent->DeactivateImmediate();
+    NiagaraComponent->SetVisibleFlag(false);
+
+    BillboardComponent->SetVisibleFlag(false);
+
+    SetActorHiddenInGame(true);
+    bIsInitialized = false;
+}
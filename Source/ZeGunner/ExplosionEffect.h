@@ -12,11 +12,15 @@ class UParticleSystemComponent;
 class UNiagaraComponent;
 class UDecalComponent;
 class UAudioComponent;
+class UMaterialBillboardComponent;
+class UMaterialInstanceDynamic;
+class UExplosionPoolSubsystem;
 
 /**
  * Explosion effect actor that can be spawned at hit locations.
  * Supports both Cascade particle systems and Niagara systems from the Fire_EXP package.
  * Provides customization options for scale, sound, decals, and camera shake.
+ * In game worlds instances come from UExplosionPoolSubsystem and go back to it when they finish.
  */
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class ZEGUNNER_API AExplosionEffect : public AActor
@@ -27,7 +31,8 @@ public:
     AExplosionEffect();
 
     /**
-     * Initialize and spawn the explosion effect with the given configuration
+     * Initialize and spawn the explosion effect with the given configuration.
+     * Re-arms a dormant pooled instance: unhides it and restarts its effects and cleanup timer.
      * @param Config - The explosion configuration to use
      */
     UFUNCTION(BlueprintCallable, Category = "Explosion")
@@ -58,6 +63,12 @@ public:
         float Scale = 1.0f,
         float LifeSpan = 5.0f);
 
+    /** Set by the pool that spawned this explosion; cleanup then returns it instead of destroying it */
+    void SetOwningPool(UExplosionPoolSubsystem* Pool) { OwningPool = Pool; }
+
+    /** Stop effects and timers, hide the actor and wait for the next InitializeExplosion */
+    void ReturnToPool();
+
 protected:
     virtual void BeginPlay() override;
     virtual void Tick(float DeltaTime) override;
@@ -74,6 +85,14 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Explosion")
     UAudioComponent* AudioComponent;
 
+    /** Flipbook billboard for the far LOD tier */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Explosion")
+    UMaterialBillboardComponent* BillboardComponent;
+
+    /** Instance of the billboard material, kept across re-arms while the material stays the same */
+    UPROPERTY(Transient)
+    UMaterialInstanceDynamic* BillboardMaterialInstance;
+
     /** Optional decal component for scorch marks */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Explosion")
     UDecalComponent* DecalComponent;
@@ -89,6 +108,9 @@ protected:
     /** Timer handle for cleanup */
     FTimerHandle CleanupTimerHandle;
 
+    /** Pool this explosion returns to when it finishes (unset for standalone spawns) */
+    TWeakObjectPtr<UExplosionPoolSubsystem> OwningPool;
+
     /** Apply the explosion configuration */
     void ApplyConfiguration();
 
@@ -98,6 +120,9 @@ protected:
     /** Spawn the Niagara effect */
     void SpawnNiagaraEffect();
 
+    /** Show the flipbook billboard, restarting its animation */
+    void SpawnBillboardEffect();
+
     /** Play explosion sound */
     void PlayExplosionSound();
 
@@ -107,7 +132,7 @@ protected:
     /** Apply camera shake to nearby players */
     void ApplyCameraShake();
 
-    /** Cleanup and destroy the actor */
+    /** Return the actor to its pool, or destroy it if it has none */
     UFUNCTION()
     void CleanupExplosion();
 };
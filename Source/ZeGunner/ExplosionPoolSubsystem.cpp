@@ -0,0 +1,141 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ExplosionPoolSubsystem.h"
+#include "ExplosionEffect.h"
+#include "ZeGunner.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Explosions Active"), STAT_ExplosionsActive, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Explosions Pooled"), STAT_ExplosionsPooled, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Explosion Pool High Water"), STAT_ExplosionPoolHighWater, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Explosion Pool Occupancy %"), STAT_ExplosionPoolOccupancy, STATGROUP_ZeGunner);
+
+bool UExplosionPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UExplosionPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExplosionPoolSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Pool ====================
+
+void UExplosionPoolSubsystem::Prewarm(int32 Count)
+{
+	PrewarmCount = FMath::Max(PrewarmCount, Count);
+
+	while (GetCapacity() < PrewarmCount)
+	{
+		AExplosionEffect* Explosion = SpawnPooledExplosion();
+		if (!Explosion)
+		{
+			break;
+		}
+		FreeExplosions.Add(Explosion);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ExplosionPool: Prewarmed %d explosions"), FreeExplosions.Num());
+	UpdateStats();
+}
+
+AExplosionEffect* UExplosionPoolSubsystem::Acquire()
+{
+	AExplosionEffect* Explosion = nullptr;
+	while (!Explosion && FreeExplosions.Num() > 0)
+	{
+		Explosion = FreeExplosions.Pop(EAllowShrinking::No);
+		if (!IsValid(Explosion))
+		{
+			Explosion = nullptr;
+		}
+	}
+
+	if (!Explosion)
+	{
+		Explosion = SpawnPooledExplosion();
+		if (!Explosion)
+		{
+			return nullptr;
+		}
+		UE_LOG(LogTemp, Log, TEXT("ExplosionPool: Pool empty, spawned a new explosion (%d playing)"), ActiveExplosions.Num() + 1);
+	}
+
+	ActiveExplosions.Add(Explosion);
+	HighWaterMark = FMath::Max(HighWaterMark, ActiveExplosions.Num());
+	UpdateStats();
+
+	return Explosion;
+}
+
+void UExplosionPoolSubsystem::Release(AExplosionEffect* Explosion)
+{
+	if (!Explosion || ActiveExplosions.RemoveSingleSwap(Explosion, EAllowShrinking::No) == 0)
+	{
+		return;
+	}
+
+	Explosion->ReturnToPool();
+	FreeExplosions.Add(Explosion);
+	UpdateStats();
+}
+
+AExplosionEffect* UExplosionPoolSubsystem::SpawnPooledExplosion()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	SpawnParams.bDeferConstruction = true;
+
+	AExplosionEffect* Explosion = World->SpawnActor<AExplosionEffect>(AExplosionEffect::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!Explosion)
+	{
+		return nullptr;
+	}
+
+	// Pooled explosions are retired by their cleanup timer, not by an actor lifespan
+	Explosion->SetOwningPool(this);
+	Explosion->FinishSpawning(FTransform::Identity);
+	Explosion->ReturnToPool();
+	return Explosion;
+}
+
+int32 UExplosionPoolSubsystem::GetTargetCapacity() const
+{
+	const int32 WithHeadroom = HighWaterMark + FMath::CeilToInt32(HighWaterMark * GrowthHeadroom);
+	return FMath::Max(PrewarmCount, WithHeadroom);
+}
+
+// ==================== Tick ====================
+
+void UExplosionPoolSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Grow toward the target a little at a time so topping up never costs a burst of spawns
+	const int32 NumToSpawn = FMath::Min(GetTargetCapacity() - GetCapacity(), MaxGrowthPerTick);
+	for (int32 i = 0; i < NumToSpawn; ++i)
+	{
+		if (AExplosionEffect* Explosion = SpawnPooledExplosion())
+		{
+			FreeExplosions.Add(Explosion);
+		}
+	}
+
+	UpdateStats();
+}
+
+void UExplosionPoolSubsystem::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_ExplosionsActive, ActiveExplosions.Num());
+	SET_DWORD_STAT(STAT_ExplosionsPooled, FreeExplosions.Num());
+	SET_DWORD_STAT(STAT_ExplosionPoolHighWater, HighWaterMark);
+	SET_DWORD_STAT(STAT_ExplosionPoolOccupancy, FMath::RoundToInt32(GetOccupancy() * 100.0f));
+}
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExplosionPoolSubsystem.generated.h"
+
+class AExplosionEffect;
+
+/**
+ * Recycles explosion actors instead of spawning and destroying one per enemy death.
+ * Dormant explosions stay hidden with their effects off; AExplosionEffect::SpawnExplosion takes one,
+ * moves it into place and re-arms it, and its cleanup timer hands it back.
+ * The pool grows on demand and then tops itself up a few actors per frame, keeping headroom
+ * above the high-water mark so the next burst of kills finds idle instances waiting.
+ */
+UCLASS()
+class ZEGUNNER_API UExplosionPoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return GetCapacity() < GetTargetCapacity(); }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Spawn dormant explosions up front so the first kills don't hitch */
+	void Prewarm(int32 Count);
+
+	/** Take a dormant explosion (spawning one if none is idle); the caller places and initializes it */
+	AExplosionEffect* Acquire();
+
+	/** Hand an explosion back; it is hidden and parked until the next Acquire */
+	void Release(AExplosionEffect* Explosion);
+
+	/** Explosions currently playing */
+	int32 GetNumActive() const { return ActiveExplosions.Num(); }
+
+	/** Dormant explosions waiting to be re-armed */
+	int32 GetNumPooled() const { return FreeExplosions.Num(); }
+
+	/** Most explosions playing at once since the level started */
+	int32 GetHighWaterMark() const { return HighWaterMark; }
+
+	/** Share of the pool's actors currently playing (0-1) */
+	float GetOccupancy() const { return GetCapacity() > 0 ? float(ActiveExplosions.Num()) / float(GetCapacity()) : 0.0f; }
+
+private:
+	/** Idle instances kept beyond the high-water mark, as a fraction of it */
+	static constexpr float GrowthHeadroom = 0.5f;
+
+	/** Most dormant explosions spawned per frame while topping up */
+	static constexpr int32 MaxGrowthPerTick = 2;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AExplosionEffect>> FreeExplosions;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AExplosionEffect>> ActiveExplosions;
+
+	int32 HighWaterMark = 0;
+
+	/** Size asked for by Prewarm; the pool never aims below it */
+	int32 PrewarmCount = 0;
+
+	int32 GetCapacity() const { return FreeExplosions.Num() + ActiveExplosions.Num(); }
+	int32 GetTargetCapacity() const;
+
+	AExplosionEffect* SpawnPooledExplosion();
+
+	void UpdateStats() const;
+};
@@ -0,0 +1,261 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ExplosionSchedulerSubsystem.h"
+#include "ExplosionEffect.h"
+#include "ExplosionBatchSubsystem.h"
+#include "ExplosionConfigAsset.h"
+#include "ZeGunner.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Explosion Schedule"), STAT_ExplosionSchedule, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Requests"), STAT_ExplosionRequests, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions Merged"), STAT_ExplosionsMerged, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions Over Budget"), STAT_ExplosionsOverBudget, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Explosions Playing"), STAT_ExplosionsPlaying, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions LOD Reduced"), STAT_ExplosionsLODReduced, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions LOD Billboard"), STAT_ExplosionsLODBillboard, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions LOD Skipped"), STAT_ExplosionsLODSkipped, STATGROUP_ZeGunner);
+
+static TAutoConsoleVariable<float> CVarExplosionMergeRadius(
+	TEXT("ZeGunner.Explosion.MergeRadius"),
+	400.0f,
+	TEXT("Explosions of the same effect requested in the same frame within this distance play as one, scaled up by count (units, 0 = never merge)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarExplosionMaxConcurrent(
+	TEXT("ZeGunner.Explosion.MaxConcurrent"),
+	24,
+	TEXT("Most explosions playing at once; lower-priority requests past the cap are dropped (0 = no cap)."),
+	ECVF_Default);
+
+bool UExplosionSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UExplosionSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExplosionSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Requests ====================
+
+const FExplosionConfig* FExplosionRequest::GetConfig() const
+{
+	if (InlineConfig.IsSet())
+	{
+		return &InlineConfig.GetValue();
+	}
+
+	const UExplosionConfigAsset* Asset = SharedConfig.Get();
+	return Asset ? &Asset->Config : nullptr;
+}
+
+void UExplosionSchedulerSubsystem::RequestExplosion(const FVector& Location, const FExplosionConfig& Config, const FVector& Normal)
+{
+	FExplosionRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Location = Location;
+	Request.Normal = Normal;
+	Request.InlineConfig = Config;
+	Request.SoundVolume = Config.SoundVolume;
+}
+
+void UExplosionSchedulerSubsystem::RequestExplosion(const FVector& Location, const UExplosionConfigAsset& SharedConfig, float SoundVolume, const FVector& Normal)
+{
+	FExplosionRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Location = Location;
+	Request.Normal = Normal;
+	Request.SharedConfig = &SharedConfig;
+	Request.SoundVolume = SoundVolume;
+}
+
+// ==================== Tick ====================
+
+void UExplosionSchedulerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	Flush();
+}
+
+void UExplosionSchedulerSubsystem::Flush()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ExplosionSchedule);
+
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+
+	// Forget explosions that have finished playing
+	for (int32 Index = PlayingEndTimes.Num() - 1; Index >= 0; --Index)
+	{
+		if (PlayingEndTimes[Index] <= Now)
+		{
+			PlayingEndTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	UpdateView();
+	BuildClusters(FMath::Max(CVarExplosionMergeRadius.GetValueOnGameThread(), 0.0f));
+	PrioritizeClusters();
+
+	const int32 MaxConcurrent = CVarExplosionMaxConcurrent.GetValueOnGameThread();
+	int32 Budget = MaxConcurrent > 0 ? FMath::Max(MaxConcurrent - PlayingEndTimes.Num(), 0) : MAX_int32;
+	int32 NumDropped = 0;
+	int32 NumPerLOD[4] = {};
+
+	UExplosionBatchSubsystem* Batch = World->GetSubsystem<UExplosionBatchSubsystem>();
+
+	for (FExplosionCluster& Cluster : Clusters)
+	{
+		// Grow with the cube root of the count, as if the merged blasts' volumes were added up
+		Cluster.Config.ExplosionScale *= FMath::Min(FMath::Pow(float(Cluster.Count), 1.0f / 3.0f), MaxMergedScale);
+
+		const EExplosionLOD LOD = Cluster.Config.SelectLOD(GetEffectiveDistance(Cluster.GetCenter()));
+		Cluster.Config.ApplyLOD(LOD);
+		++NumPerLOD[static_cast<int32>(LOD)];
+
+		// Too far to see: the sound still plays, nothing is drawn
+		if (LOD == EExplosionLOD::Skip)
+		{
+			if (Cluster.Config.ExplosionSound)
+			{
+				UGameplayStatics::PlaySoundAtLocation(World, Cluster.Config.ExplosionSound, Cluster.GetCenter(), Cluster.Config.SoundVolume);
+			}
+			continue;
+		}
+
+		// Batched explosions are entries in a shared system, not systems of their own, so the cap doesn't apply
+		if (Batch && Batch->AddExplosion(Cluster.GetCenter(), Cluster.Config))
+		{
+			continue;
+		}
+
+		if (Budget <= 0)
+		{
+			++NumDropped;
+			continue;
+		}
+
+		if (AExplosionEffect::SpawnExplosion(World, Cluster.GetCenter(), Cluster.Config, Cluster.Normal))
+		{
+			PlayingEndTimes.Add(Now + FMath::Max(Cluster.Config.LifeSpan, 0.1f));
+			--Budget;
+		}
+	}
+
+	if (NumDropped > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("ExplosionScheduler: %d explosions over the budget of %d were dropped"), NumDropped, MaxConcurrent);
+	}
+
+	SET_DWORD_STAT(STAT_ExplosionRequests, PendingRequests.Num());
+	SET_DWORD_STAT(STAT_ExplosionsMerged, PendingRequests.Num() - Clusters.Num());
+	SET_DWORD_STAT(STAT_ExplosionsOverBudget, NumDropped);
+	SET_DWORD_STAT(STAT_ExplosionsPlaying, PlayingEndTimes.Num());
+	SET_DWORD_STAT(STAT_ExplosionsLODReduced, NumPerLOD[static_cast<int32>(EExplosionLOD::Reduced)]);
+	SET_DWORD_STAT(STAT_ExplosionsLODBillboard, NumPerLOD[static_cast<int32>(EExplosionLOD::Billboard)]);
+	SET_DWORD_STAT(STAT_ExplosionsLODSkipped, NumPerLOD[static_cast<int32>(EExplosionLOD::Skip)]);
+
+	PendingRequests.Reset();
+	Clusters.Reset();
+}
+
+void UExplosionSchedulerSubsystem::BuildClusters(float MergeRadius)
+{
+	const double MergeRadiusSquared = FMath::Square(MergeRadius);
+
+	// A frame holds a handful of requests even in a big wave, so a linear scan beats a grid here
+	for (const FExplosionRequest& Request : PendingRequests)
+	{
+		const FExplosionConfig* Config = Request.GetConfig();
+		if (!Config)
+		{
+			continue;
+		}
+
+		const FVector Location = Request.Location + Config->LocationOffset;
+
+		FExplosionCluster* Match = nullptr;
+		if (MergeRadius > 0.0f)
+		{
+			for (FExplosionCluster& Cluster : Clusters)
+			{
+				const bool bSameEffect = Cluster.Config.NiagaraSystem == Config->NiagaraSystem
+					&& Cluster.Config.ParticleSystem == Config->ParticleSystem
+					&& Cluster.Config.BatchedNiagaraSystem == Config->BatchedNiagaraSystem;
+				if (bSameEffect && FVector::DistSquared(Cluster.GetCenter(), Location) <= MergeRadiusSquared)
+				{
+					Match = &Cluster;
+					break;
+				}
+			}
+		}
+
+		if (!Match)
+		{
+			// The one copy per cluster; scale and LOD are applied to it when it spawns
+			Match = &Clusters.AddDefaulted_GetRef();
+			Match->Config = *Config;
+			Match->Config.SoundVolume = Request.SoundVolume;
+			Match->Normal = Request.Normal;
+
+			// The offset is already folded into the cluster center
+			Match->Config.LocationOffset = FVector::ZeroVector;
+		}
+
+		Match->LocationSum += Location;
+		++Match->Count;
+	}
+}
+
+void UExplosionSchedulerSubsystem::UpdateView()
+{
+	View.bValid = false;
+
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->PlayerCameraManager)
+	{
+		return;
+	}
+
+	// The cached view carries the camera component's FOV, so turret zoom narrows the favored cone
+	const FMinimalViewInfo& CameraView = PC->PlayerCameraManager->GetCameraCacheView();
+	const float HalfFOV = FMath::DegreesToRadians(FMath::Clamp(CameraView.FOV, 1.0f, 170.0f) * 0.5f);
+
+	View.Location = CameraView.Location;
+	View.Forward = CameraView.Rotation.Vector();
+	View.CosHalfFOV = FMath::Cos(HalfFOV);
+
+	// How much smaller things look than through the unzoomed 90 degree turret camera
+	View.ZoomScale = FMath::Tan(HalfFOV) / FMath::Tan(FMath::DegreesToRadians(UnzoomedFOV * 0.5f));
+	View.bValid = true;
+}
+
+float UExplosionSchedulerSubsystem::GetEffectiveDistance(const FVector& Location) const
+{
+	return View.bValid ? FVector::Dist(Location, View.Location) * View.ZoomScale : 0.0f;
+}
+
+void UExplosionSchedulerSubsystem::PrioritizeClusters()
+{
+	if (Clusters.Num() < 2 || !View.bValid)
+	{
+		return;
+	}
+
+	for (FExplosionCluster& Cluster : Clusters)
+	{
+		const FVector ToCluster = Cluster.GetCenter() - View.Location;
+		const float Distance = ToCluster.Size();
+		const bool bInView = FVector::DotProduct(ToCluster, View.Forward) >= View.CosHalfFOV * Distance;
+
+		// Anything on screen outranks anything off it; within each group nearer wins
+		Cluster.Priority = (bInView ? 1.0f : 0.0f) + 0.5f / (1.0f + Distance * 0.001f);
+	}
+
+	Clusters.Sort([](const FExplosionCluster& A, const FExplosionCluster& B) { return A.Priority > B.Priority; });
+}
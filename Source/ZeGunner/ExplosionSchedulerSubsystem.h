@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExplosionTypes.h"
+#include "ExplosionSchedulerSubsystem.generated.h"
+
+class UExplosionConfigAsset;
+
+/** One explosion asked for this frame */
+struct FExplosionRequest
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::UpVector;
+
+	/** Shared config the explosion plays; only referenced, never copied per request */
+	TWeakObjectPtr<const UExplosionConfigAsset> SharedConfig;
+
+	/** Copy for explosions without a shared config (one-off spawns, enemies not yet on an asset) */
+	TOptional<FExplosionConfig> InlineConfig;
+
+	/** Player volume, which overrides the config's SoundVolume */
+	float SoundVolume = 1.0f;
+
+	/** The config to play, or null if the shared asset has gone away */
+	const FExplosionConfig* GetConfig() const;
+};
+
+/** Requests of the same effect close enough together to play as one explosion */
+struct FExplosionCluster
+{
+	/** Config of the first request, scaled up by Count when spawned */
+	FExplosionConfig Config;
+	FVector Normal = FVector::UpVector;
+
+	FVector LocationSum = FVector::ZeroVector;
+	int32 Count = 0;
+
+	/** Higher plays first when the concurrent budget is short */
+	float Priority = 0.0f;
+
+	FVector GetCenter() const { return Count > 0 ? LocationSum / Count : FVector::ZeroVector; }
+};
+
+/**
+ * Frame-local explosion queue in front of AExplosionEffect. Requests made during a frame are
+ * merged when they play the same effect within ZeGunner.Explosion.MergeRadius of each other,
+ * so a cluster of kills becomes one bigger explosion instead of a stack of identical ones.
+ * The merged explosions then spawn under a global cap on concurrently playing explosions
+ * (ZeGunner.Explosion.MaxConcurrent); inside the turret's view and near the camera go first,
+ * and whatever doesn't fit the budget this frame is dropped. Types with a batched Niagara system
+ * go to UExplosionBatchSubsystem instead and don't count against the cap.
+ * Each explosion's LOD tier (FExplosionConfig::SelectLOD) is picked here from its camera
+ * distance scaled by the turret zoom, before it is spawned.
+ */
+UCLASS()
+class ZEGUNNER_API UExplosionSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return PendingRequests.Num() > 0 || PlayingEndTimes.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Queue an explosion; it is merged, prioritized and spawned with the rest of this frame's requests */
+	void RequestExplosion(const FVector& Location, const FExplosionConfig& Config, const FVector& Normal = FVector::UpVector);
+
+	/** Queue an explosion of a shared config by reference, at the player's SoundVolume */
+	void RequestExplosion(const FVector& Location, const UExplosionConfigAsset& SharedConfig, float SoundVolume, const FVector& Normal = FVector::UpVector);
+
+	/** Explosions spawned by the scheduler that haven't reached the end of their lifespan */
+	int32 GetNumPlaying() const { return PlayingEndTimes.Num(); }
+
+private:
+	/** Largest scale-up a merged explosion gets, however many requests it absorbed */
+	static constexpr float MaxMergedScale = 3.0f;
+
+	/** Turret camera FOV at zoom 1x; LOD distances are tuned for it */
+	static constexpr float UnzoomedFOV = 90.0f;
+
+	/** Turret camera this frame, for priority and LOD */
+	struct FSchedulerView
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Forward = FVector::ForwardVector;
+		float CosHalfFOV = 0.0f;
+
+		/** Apparent size factor of the current zoom (1 unzoomed, smaller when zoomed in) */
+		float ZoomScale = 1.0f;
+
+		bool bValid = false;
+	};
+	FSchedulerView View;
+
+	TArray<FExplosionRequest> PendingRequests;
+
+	/** Scratch buffer for this frame's merged explosions */
+	TArray<FExplosionCluster> Clusters;
+
+	/** World time each playing explosion finishes */
+	TArray<double> PlayingEndTimes;
+
+	/** Merge, prioritize and spawn this frame's requests */
+	void Flush();
+
+	/** Fold each pending request into the first cluster of the same effect in range */
+	void BuildClusters(float MergeRadius);
+
+	/** Cache the turret camera's location, direction and zoom for this frame */
+	void UpdateView();
+
+	/** Camera distance scaled by zoom, as LOD tiers measure it (0 without a view, so everything is full detail) */
+	float GetEffectiveDistance(const FVector& Location) const;
+
+	/** Rank clusters by whether the turret camera sees them, then by distance to it */
+	void PrioritizeClusters();
+};
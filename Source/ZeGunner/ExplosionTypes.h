@@ -6,6 +6,16 @@
 #include "NiagaraSystem.h"
 #include "ExplosionTypes.generated.h"
 
+/** Level of detail an explosion is drawn at, cheapest last */
+UENUM(BlueprintType)
+enum class EExplosionLOD : uint8
+{
+    Full,       // The config's Niagara or Cascade system
+    Reduced,    // The reduced-cost system
+    Billboard,  // A single flipbook billboard
+    Skip        // Sound only, nothing drawn
+};
+
 /**
  * Configuration for an explosion effect
  * Allows customization of particle system, sound, decal, and damage
@@ -27,6 +37,13 @@ struct FExplosionConfig
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
     UNiagaraSystem* NiagaraSystem = nullptr;
 
+    /**
+     * Optional: Niagara system that draws every explosion of this type from one shared component
+     * (reads the event arrays described on UExplosionBatchSubsystem). Replaces the explosion actor when set.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
+    UNiagaraSystem* BatchedNiagaraSystem = nullptr;
+
     /** Sound effect to play on explosion */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
     USoundBase* ExplosionSound = nullptr;
@@ -67,11 +84,45 @@ struct FExplosionConfig
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion")
     FVector LocationOffset = FVector::ZeroVector;
 
+    // ==================== LOD ====================
+    // Distances are measured from the camera and divided by the turret zoom, so a zoomed-in
+    // view of a far kill gets the same tier as an unzoomed view of a near one. A tier whose
+    // asset isn't set falls back to the richer tier before it.
+
+    /** Optional: cheaper Cascade system used from ReducedDistance */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion LOD")
+    UParticleSystem* ReducedParticleSystem = nullptr;
+
+    /** Optional: cheaper Niagara system used from ReducedDistance */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion LOD")
+    UNiagaraSystem* ReducedNiagaraSystem = nullptr;
+
+    /** Optional: flipbook material drawn on one billboard from BillboardDistance (its StartTime scalar is set to the spawn time) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion LOD")
+    UMaterialInterface* BillboardMaterial = nullptr;
+
+    /** World size of the flipbook billboard before ExplosionScale */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion LOD", meta = (ClampMin = "1.0"))
+    float BillboardSize = 600.0f;
+
+    /** Zoom-adjusted camera distance where the reduced system takes over (0 = never) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion LOD", meta = (ClampMin = "0.0"))
+    float ReducedDistance = 8000.0f;
+
+    /** Zoom-adjusted camera distance where the billboard takes over (0 = never) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion LOD", meta = (ClampMin = "0.0"))
+    float BillboardDistance = 16000.0f;
+
+    /** Zoom-adjusted camera distance past which nothing is drawn, only the sound plays (0 = never) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion LOD", meta = (ClampMin = "0.0"))
+    float SkipDistance = 0.0f;
+
     FExplosionConfig()
     {
         DisplayName = TEXT("Default Explosion");
         ParticleSystem = nullptr;
         NiagaraSystem = nullptr;
+        BatchedNiagaraSystem = nullptr;
         ExplosionSound = nullptr;
         SoundVolume = 1.0f;
         DecalMaterial = nullptr;
@@ -82,5 +133,55 @@ struct FExplosionConfig
         CameraShakeRadius = 2000.0f;
         bRandomRotation = true;
         LocationOffset = FVector::ZeroVector;
+        ReducedParticleSystem = nullptr;
+        ReducedNiagaraSystem = nullptr;
+        BillboardMaterial = nullptr;
+        BillboardSize = 600.0f;
+        ReducedDistance = 8000.0f;
+        BillboardDistance = 16000.0f;
+        SkipDistance = 0.0f;
+    }
+
+    /** Tier to draw at for a zoom-adjusted camera distance, skipping tiers with no asset */
+    EExplosionLOD SelectLOD(float EffectiveDistance) const
+    {
+        if (SkipDistance > 0.0f && EffectiveDistance >= SkipDistance)
+        {
+            return EExplosionLOD::Skip;
+        }
+        if (BillboardMaterial && BillboardDistance > 0.0f && EffectiveDistance >= BillboardDistance)
+        {
+            return EExplosionLOD::Billboard;
+        }
+        if ((ReducedNiagaraSystem || ReducedParticleSystem) && ReducedDistance > 0.0f && EffectiveDistance >= ReducedDistance)
+        {
+            return EExplosionLOD::Reduced;
+        }
+        return EExplosionLOD::Full;
+    }
+
+    /** Swap in the assets of a tier; Full leaves the config as it is. A batched system is only dropped by Skip. */
+    void ApplyLOD(EExplosionLOD LOD)
+    {
+        switch (LOD)
+        {
+        case EExplosionLOD::Reduced:
+            NiagaraSystem = ReducedNiagaraSystem;
+            ParticleSystem = ReducedParticleSystem;
+            break;
+        case EExplosionLOD::Billboard:
+            NiagaraSystem = nullptr;
+            ParticleSystem = nullptr;
+            break;
+        case EExplosionLOD::Skip:
+            NiagaraSystem = nullptr;
+            ParticleSystem = nullptr;
+            BatchedNiagaraSystem = nullptr;
+            BillboardMaterial = nullptr;
+            DecalMaterial = nullptr;
+            break;
+        default:
+            break;
+        }
     }
 };
@@ -2,13 +2,10 @@
 
 #include "FighterHUD.h"
 #include "FighterPawn.h"
-#include "TankAI.h"
-#include "HeliAI.h"
-#include "UFOAI.h"
+#include "EnemyRegistrySubsystem.h"
 #include "Engine/Canvas.h"
 #include "Engine/Font.h"
 #include "GameFramework/PlayerController.h"
-#include "EngineUtils.h"
 
 AFighterHUD::AFighterHUD()
 {
@@ -371,129 +368,131 @@ void AFighterHUD::DrawRadar(AFighterPawn* Fighter)
 	float EffectiveRange = RadarWorldRange * Fighter->GetRadarZoom();
 	float Scale = RadarRadius / EffectiveRange;
 
-	// --- Draw tanks (red dots) ---
-	for (TActorIterator<ATankAI> It(World); It; ++It)
+	// --- Enemies come straight from the registry's typed lists ---
+	UEnemyRegistrySubsystem* Registry = World->GetSubsystem<UEnemyRegistrySubsystem>();
+	if (Registry)
 	{
-		ATankAI* Tank = *It;
-		if (!Tank) continue;
-
-		FVector RelPos = Tank->GetActorLocation() - PlayerPos;
-
-		// Rotate relative to player's yaw (so forward is always up on radar)
-		float RotX = RelPos.X * FMath::Cos(-PlayerYawRad) - RelPos.Y * FMath::Sin(-PlayerYawRad);
-		float RotY = RelPos.X * FMath::Sin(-PlayerYawRad) + RelPos.Y * FMath::Cos(-PlayerYawRad);
-
-		// Map to radar space (UE: X=forward, Y=right -> Radar: up=-Y screen, right=+X screen)
-		float DotX = RadarCX + RotY * Scale;
-		float DotY = RadarCY - RotX * Scale;
-
-		// Clamp to radar circle
-		float Margin = RadarDotSize + 1.0f;
-		float ClampRadius = RadarRadius - Margin;
-		float DxFromCenter = DotX - RadarCX;
-		float DyFromCenter = DotY - RadarCY;
-		float DistFromCenter = FMath::Sqrt(DxFromCenter * DxFromCenter + DyFromCenter * DyFromCenter);
-		if (DistFromCenter > ClampRadius)
+		// --- Draw tanks (red dots) ---
+		for (APawn* Tank : Registry->GetEnemies(EEnemyType::Tank))
 		{
-			float ScaleFactor = ClampRadius / DistFromCenter;
-			DotX = RadarCX + DxFromCenter * ScaleFactor;
-			DotY = RadarCY + DyFromCenter * ScaleFactor;
+			if (!Tank) continue;
+
+			FVector RelPos = Tank->GetActorLocation() - PlayerPos;
+
+			// Rotate relative to player's yaw (so forward is always up on radar)
+			float RotX = RelPos.X * FMath::Cos(-PlayerYawRad) - RelPos.Y * FMath::Sin(-PlayerYawRad);
+			float RotY = RelPos.X * FMath::Sin(-PlayerYawRad) + RelPos.Y * FMath::Cos(-PlayerYawRad);
+
+			// Map to radar space (UE: X=forward, Y=right -> Radar: up=-Y screen, right=+X screen)
+			float DotX = RadarCX + RotY * Scale;
+			float DotY = RadarCY - RotX * Scale;
+
+			// Clamp to radar circle
+			float Margin = RadarDotSize + 1.0f;
+			float ClampRadius = RadarRadius - Margin;
+			float DxFromCenter = DotX - RadarCX;
+			float DyFromCenter = DotY - RadarCY;
+			float DistFromCenter = FMath::Sqrt(DxFromCenter * DxFromCenter + DyFromCenter * DyFromCenter);
+			if (DistFromCenter > ClampRadius)
+			{
+				float ScaleFactor = ClampRadius / DistFromCenter;
+				DotX = RadarCX + DxFromCenter * ScaleFactor;
+				DotY = RadarCY + DyFromCenter * ScaleFactor;
+			}
+
+			// Draw red filled dot (diamond shape for tanks)
+			float S = RadarDotSize;
+			Canvas->K2_DrawLine(FVector2D(DotX, DotY - S), FVector2D(DotX + S, DotY), 2.0f, RadarTankColor);
+			Canvas->K2_DrawLine(FVector2D(DotX + S, DotY), FVector2D(DotX, DotY + S), 2.0f, RadarTankColor);
+			Canvas->K2_DrawLine(FVector2D(DotX, DotY + S), FVector2D(DotX - S, DotY), 2.0f, RadarTankColor);
+			Canvas->K2_DrawLine(FVector2D(DotX - S, DotY), FVector2D(DotX, DotY - S), 2.0f, RadarTankColor);
 		}
 
-		// Draw red filled dot (diamond shape for tanks)
-		float S = RadarDotSize;
-		Canvas->K2_DrawLine(FVector2D(DotX, DotY - S), FVector2D(DotX + S, DotY), 2.0f, RadarTankColor);
-		Canvas->K2_DrawLine(FVector2D(DotX + S, DotY), FVector2D(DotX, DotY + S), 2.0f, RadarTankColor);
-		Canvas->K2_DrawLine(FVector2D(DotX, DotY + S), FVector2D(DotX - S, DotY), 2.0f, RadarTankColor);
-		Canvas->K2_DrawLine(FVector2D(DotX - S, DotY), FVector2D(DotX, DotY - S), 2.0f, RadarTankColor);
-	}
-
-	// --- Draw helicopters (yellow dots with height bar) ---
-	for (TActorIterator<AHeliAI> It(World); It; ++It)
-	{
-		AHeliAI* Heli = *It;
-		if (!Heli) continue;
-
-		FVector HeliPos = Heli->GetActorLocation();
-		FVector RelPos = HeliPos - PlayerPos;
-
-		// Rotate relative to player's yaw
-		float RotX = RelPos.X * FMath::Cos(-PlayerYawRad) - RelPos.Y * FMath::Sin(-PlayerYawRad);
-		float RotY = RelPos.X * FMath::Sin(-PlayerYawRad) + RelPos.Y * FMath::Cos(-PlayerYawRad);
-
-		// Map to radar space
-		float DotX = RadarCX + RotY * Scale;
-		float DotY = RadarCY - RotX * Scale;
-
-		// Clamp to radar circle
-		float Margin = RadarDotSize + 1.0f;
-		float ClampRadius = RadarRadius - Margin;
-		float DxFromCenter = DotX - RadarCX;
-		float DyFromCenter = DotY - RadarCY;
-		float DistFromCenter = FMath::Sqrt(DxFromCenter * DxFromCenter + DyFromCenter * DyFromCenter);
-		if (DistFromCenter > ClampRadius)
+		// --- Draw helicopters (yellow dots with height bar) ---
+		for (APawn* Heli : Registry->GetEnemies(EEnemyType::Heli))
 		{
-			float ScaleFactor = ClampRadius / DistFromCenter;
-			DotX = RadarCX + DxFromCenter * ScaleFactor;
-			DotY = RadarCY + DyFromCenter * ScaleFactor;
+			if (!Heli) continue;
+
+			FVector HeliPos = Heli->GetActorLocation();
+			FVector RelPos = HeliPos - PlayerPos;
+
+			// Rotate relative to player's yaw
+			float RotX = RelPos.X * FMath::Cos(-PlayerYawRad) - RelPos.Y * FMath::Sin(-PlayerYawRad);
+			float RotY = RelPos.X * FMath::Sin(-PlayerYawRad) + RelPos.Y * FMath::Cos(-PlayerYawRad);
+
+			// Map to radar space
+			float DotX = RadarCX + RotY * Scale;
+			float DotY = RadarCY - RotX * Scale;
+
+			// Clamp to radar circle
+			float Margin = RadarDotSize + 1.0f;
+			float ClampRadius = RadarRadius - Margin;
+			float DxFromCenter = DotX - RadarCX;
+			float DyFromCenter = DotY - RadarCY;
+			float DistFromCenter = FMath::Sqrt(DxFromCenter * DxFromCenter + DyFromCenter * DyFromCenter);
+			if (DistFromCenter > ClampRadius)
+			{
+				float ScaleFactor = ClampRadius / DistFromCenter;
+				DotX = RadarCX + DxFromCenter * ScaleFactor;
+				DotY = RadarCY + DyFromCenter * ScaleFactor;
+			}
+
+			// Draw yellow circle dot for helis
+			DrawCircle(DotX, DotY, RadarDotSize, 8, RadarHeliColor, 2.0f);
+
+			// Draw vertical height bar below the dot
+			float HeliAlt = FMath::Max(0.0f, HeliPos.Z);
+			float BarLength = FMath::Clamp(HeliAlt / RadarHeliMaxAltitude, 0.0f, 1.0f) * RadarHeliBarMaxLength;
+			if (BarLength > 1.0f)
+			{
+				Canvas->K2_DrawLine(
+					FVector2D(DotX, DotY + RadarDotSize + 1.0f),
+					FVector2D(DotX, DotY + RadarDotSize + 1.0f + BarLength),
+					RadarHeliBarWidth, RadarHeliColor);
+			}
 		}
 
-		// Draw yellow circle dot for helis
-		DrawCircle(DotX, DotY, RadarDotSize, 8, RadarHeliColor, 2.0f);
-
-		// Draw vertical height bar below the dot
-		float HeliAlt = FMath::Max(0.0f, HeliPos.Z);
-		float BarLength = FMath::Clamp(HeliAlt / RadarHeliMaxAltitude, 0.0f, 1.0f) * RadarHeliBarMaxLength;
-		if (BarLength > 1.0f)
-		{
-			Canvas->K2_DrawLine(
-				FVector2D(DotX, DotY + RadarDotSize + 1.0f),
-				FVector2D(DotX, DotY + RadarDotSize + 1.0f + BarLength),
-				RadarHeliBarWidth, RadarHeliColor);
-		}
-	}
-
-	// --- Draw UFOs (magenta dots with height bar) ---
-	for (TActorIterator<AUFOAI> It(World); It; ++It)
-	{
-		AUFOAI* UFO = *It;
-		if (!UFO) continue;
-
-		FVector UFOPos = UFO->GetActorLocation();
-		FVector RelPos = UFOPos - PlayerPos;
-
-		float RotX = RelPos.X * FMath::Cos(-PlayerYawRad) - RelPos.Y * FMath::Sin(-PlayerYawRad);
-		float RotY = RelPos.X * FMath::Sin(-PlayerYawRad) + RelPos.Y * FMath::Cos(-PlayerYawRad);
-
-		float DotX = RadarCX + RotY * Scale;
-		float DotY = RadarCY - RotX * Scale;
-
-		float Margin = RadarDotSize + 1.0f;
-		float ClampRadius = RadarRadius - Margin;
-		float DxFromCenter = DotX - RadarCX;
-		float DyFromCenter = DotY - RadarCY;
-		float DistFromCenter = FMath::Sqrt(DxFromCenter * DxFromCenter + DyFromCenter * DyFromCenter);
-		if (DistFromCenter > ClampRadius)
-		{
-			float ScaleFactor = ClampRadius / DistFromCenter;
-			DotX = RadarCX + DxFromCenter * ScaleFactor;
-			DotY = RadarCY + DyFromCenter * ScaleFactor;
-		}
-
-		// Draw magenta X shape for UFOs
-		float S = RadarDotSize;
-		Canvas->K2_DrawLine(FVector2D(DotX - S, DotY - S), FVector2D(DotX + S, DotY + S), 2.0f, RadarUFOColor);
-		Canvas->K2_DrawLine(FVector2D(DotX + S, DotY - S), FVector2D(DotX - S, DotY + S), 2.0f, RadarUFOColor);
-
-		// Draw vertical height bar below the dot
-		float UFOAlt = FMath::Max(0.0f, UFOPos.Z);
-		float BarLength = FMath::Clamp(UFOAlt / RadarHeliMaxAltitude, 0.0f, 1.0f) * RadarHeliBarMaxLength;
-		if (BarLength > 1.0f)
+		// --- Draw UFOs (magenta dots with height bar) ---
+		for (APawn* UFO : Registry->GetEnemies(EEnemyType::UFO))
 		{
-			Canvas->K2_DrawLine(
-				FVector2D(DotX, DotY + RadarDotSize + 1.0f),
-				FVector2D(DotX, DotY + RadarDotSize + 1.0f + BarLength),
-				RadarHeliBarWidth, RadarUFOColor);
+			if (!UFO) continue;
+
+			FVector UFOPos = UFO->GetActorLocation();
+			FVector RelPos = UFOPos - PlayerPos;
+
+			float RotX = RelPos.X * FMath::Cos(-PlayerYawRad) - RelPos.Y * FMath::Sin(-PlayerYawRad);
+			float RotY = RelPos.X * FMath::Sin(-PlayerYawRad) + RelPos.Y * FMath::Cos(-PlayerYawRad);
+
+			float DotX = RadarCX + RotY * Scale;
+			float DotY = RadarCY - RotX * Scale;
+
+			float Margin = RadarDotSize + 1.0f;
+			float ClampRadius = RadarRadius - Margin;
+			float DxFromCenter = DotX - RadarCX;
+			float DyFromCenter = DotY - RadarCY;
+			float DistFromCenter = FMath::Sqrt(DxFromCenter * DxFromCenter + DyFromCenter * DyFromCenter);
+			if (DistFromCenter > ClampRadius)
+			{
+				float ScaleFactor = ClampRadius / DistFromCenter;
+				DotX = RadarCX + DxFromCenter * ScaleFactor;
+				DotY = RadarCY + DyFromCenter * ScaleFactor;
+			}
+
+			// Draw magenta X shape for UFOs
+			float S = RadarDotSize;
+			Canvas->K2_DrawLine(FVector2D(DotX - S, DotY - S), FVector2D(DotX + S, DotY + S), 2.0f, RadarUFOColor);
+			Canvas->K2_DrawLine(FVector2D(DotX + S, DotY - S), FVector2D(DotX - S, DotY + S), 2.0f, RadarUFOColor);
+
+			// Draw vertical height bar below the dot
+			float UFOAlt = FMath::Max(0.0f, UFOPos.Z);
+			float BarLength = FMath::Clamp(UFOAlt / RadarHeliMaxAltitude, 0.0f, 1.0f) * RadarHeliBarMaxLength;
+			if (BarLength > 1.0f)
+			{
+				Canvas->K2_DrawLine(
+					FVector2D(DotX, DotY + RadarDotSize + 1.0f),
+					FVector2D(DotX, DotY + RadarDotSize + 1.0f + BarLength),
+					RadarHeliBarWidth, RadarUFOColor);
+			}
 		}
 	}
 
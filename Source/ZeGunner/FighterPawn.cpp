@@ -2,12 +2,20 @@
 
 #include "FighterPawn.h"
 #include "RocketProjectile.h"
-#include "TankAI.h"
-#include "HeliAI.h"
-#include "UFOAI.h"
+#include "RocketPoolSubsystem.h"
+#include "ProjectileSubsystem.h"
+#include "TrailPoolSubsystem.h"
+#include "WeaponAudioSubsystem.h"
+#include "ExplosionPoolSubsystem.h"
+#include "ExplosionBatchSubsystem.h"
+#include "ExplosionComponent.h"
 #include "TankWaveSpawner.h"
 #include "HeliWaveSpawner.h"
 #include "SpecialWaveSpawner.h"
+#include "BaseDamageSubsystem.h"
+#include "EnemyRegistrySubsystem.h"
+#include "EnemySpatialGridSubsystem.h"
+#include "EnemyKillSubsystem.h"
 #include "Camera/CameraComponent.h"
 #include "Components/SceneComponent.h"
 #include "EnhancedInputComponent.h"
@@ -23,6 +31,19 @@
 #include "LandscapeProxy.h"
 #include "WorldPartition/WorldPartition.h"
 #include "Engine/World.h"
+#include "ZeGunner.h"
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Rockets Per Second"), STAT_RocketsPerSecond, STATGROUP_ZeGunner);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Rocket Cadence Error %"), STAT_RocketCadenceError, STATGROUP_ZeGunner);
+
+namespace
+{
+	/** Most shots emitted in one frame; a longer hitch drops the rest instead of dumping a burst */
+	constexpr int32 MaxRocketsPerFrame = 8;
+
+	/** Shortest span the fire rate is measured over */
+	constexpr double RocketRateWindowSeconds = 1.0;
+}
 
 AFighterPawn::AFighterPawn()
 {
@@ -142,15 +163,72 @@ void AFighterPawn::BeginPlay()
 		}
 	}
 
-	// Bind to existing enemy destruction events for score tracking
-	BindEnemyDestroyedEvents();
+	// Every frame's kills arrive here in one batch for score tracking
+	if (UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>())
+	{
+		Kills->OnEnemiesKilled.AddUObject(this, &AFighterPawn::OnEnemiesKilled);
+	}
+
+	// Sound code reads the cached volume instead of looking this pawn up
+	PublishSoundVolume();
+
+	// Set up the actorless simulation, or fill the rocket pool before the first volley
+	if (RocketClass && RocketClass->IsChildOf<ARocketProjectile>())
+	{
+		UProjectileSubsystem* Projectiles = GetWorld()->GetSubsystem<UProjectileSubsystem>();
+		URocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<URocketPoolSubsystem>();
+		if (bUseActorlessRockets && Projectiles)
+		{
+			Projectiles->Configure(TSubclassOf<ARocketProjectile>(RocketClass.Get()));
+		}
+		else if (RocketPool)
+		{
+			RocketPool->Prewarm(TSubclassOf<ARocketProjectile>(RocketClass.Get()), RocketPoolPrewarmCount, this);
+		}
+
+		// Both paths draw their trails from the trail pool
+		if (UTrailPoolSubsystem* TrailPool = GetWorld()->GetSubsystem<UTrailPoolSubsystem>())
+		{
+			TrailPool->Prewarm(RocketClass->GetDefaultObject<ARocketProjectile>()->GetTrailAsset(), RocketPoolPrewarmCount);
+		}
+	}
+
+	// Enemy deaths re-arm dormant explosions instead of spawning actors
+	if (UExplosionPoolSubsystem* ExplosionPool = GetWorld()->GetSubsystem<UExplosionPoolSubsystem>())
+	{
+		ExplosionPool->Prewarm(ExplosionPoolPrewarmCount);
+	}
+
+	// Batched explosion types get their persistent component now rather than on the first kill
+	for (TActorIterator<ATankWaveSpawner> It(GetWorld()); It; ++It)
+	{
+		PrewarmBatchedExplosion(It->GetTankClass());
+	}
+	for (TActorIterator<AHeliWaveSpawner> It(GetWorld()); It; ++It)
+	{
+		PrewarmBatchedExplosion(It->GetHeliClass());
+	}
+	for (TActorIterator<ASpecialWaveSpawner> It(GetWorld()); It; ++It)
+	{
+		PrewarmBatchedExplosion(It->GetUFOClass());
+	}
 
 	// Start in Instructions state
-	CurrentGameState = EGameState::Instructions;
+	SetGameState(EGameState::Instructions);
 
 	UE_LOG(LogTemp, Log, TEXT("FighterPawn: Turret initialized at position (0, 0, %.0f)"), StartAltitude);
 }
 
+void AFighterPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>())
+	{
+		Kills->OnEnemiesKilled.RemoveAll(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AFighterPawn::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -204,6 +282,9 @@ void AFighterPawn::Tick(float DeltaTime)
 		FrameMouseDeltaY = 0.0f;
 	}
 
+	// Apply this frame's hits on the base in one pass
+	ApplyQueuedBaseDamage();
+
 	// Decay damage flash
 	if (DamageFlashAlpha > 0.0f)
 	{
@@ -222,24 +303,20 @@ void AFighterPawn::Tick(float DeltaTime)
 	}
 
 	// Only run gameplay when Playing
-	if (CurrentGameState != EGameState::Playing) return;
+	if (GetGameState() != EGameState::Playing) return;
 
 	UpdateTurretAim(DeltaTime);
 	UpdateTurretHeight(DeltaTime);
 	UpdateMouseAim();
 
-	// Periodically re-bind to newly spawned enemies (every ~1 second)
-	EnemyScanTimer -= DeltaTime;
-	if (EnemyScanTimer <= 0.0f)
-	{
-		BindEnemyDestroyedEvents();
-		EnemyScanTimer = 1.0f;
-	}
-
 	// Auto-fire rockets while button is held
 	if (bFireRocketHeld)
 	{
-		FireRocket();
+		UpdateAutoFire();
+	}
+	else
+	{
+		bRocketBurstActive = false;
 	}
 }
 
@@ -389,15 +466,41 @@ void AFighterPawn::OnFireRocketReleased(const FInputActionValue& Value)
 void AFighterPawn::OnVolumeUp(const FInputActionValue& Value)
 {
 	SoundVolume = FMath::Clamp(SoundVolume + VolumeStep, 0.0f, 1.0f);
+	PublishSoundVolume();
 	UE_LOG(LogTemp, Log, TEXT("FighterPawn: Volume UP -> %.0f%%"), SoundVolume * 100.0f);
 }
 
 void AFighterPawn::OnVolumeDown(const FInputActionValue& Value)
 {
 	SoundVolume = FMath::Clamp(SoundVolume - VolumeStep, 0.0f, 1.0f);
+	PublishSoundVolume();
 	UE_LOG(LogTemp, Log, TEXT("FighterPawn: Volume DOWN -> %.0f%%"), SoundVolume * 100.0f);
 }
 
+void AFighterPawn::PublishSoundVolume() const
+{
+	if (UWeaponAudioSubsystem* WeaponAudio = GetWorld()->GetSubsystem<UWeaponAudioSubsystem>())
+	{
+		WeaponAudio->SetVolume(SoundVolume);
+	}
+}
+
+void AFighterPawn::PrewarmBatchedExplosion(const UClass* EnemyClass) const
+{
+	UExplosionBatchSubsystem* ExplosionBatch = GetWorld()->GetSubsystem<UExplosionBatchSubsystem>();
+	if (!ExplosionBatch || !EnemyClass)
+	{
+		return;
+	}
+
+	// The class default object carries the Blueprint's explosion setup
+	const AActor* EnemyDefaults = EnemyClass->GetDefaultObject<AActor>();
+	if (const UExplosionComponent* ExplosionComp = EnemyDefaults ? EnemyDefaults->FindComponentByClass<UExplosionComponent>() : nullptr)
+	{
+		ExplosionBatch->Prewarm(ExplosionComp->GetExplosionConfig().BatchedNiagaraSystem);
+	}
+}
+
 void AFighterPawn::OnSensitivityUp(const FInputActionValue& Value)
 {
 	SensitivityPercent = FMath::Clamp(SensitivityPercent + SensitivityStep, MinSensitivityPercent, MaxSensitivityPercent);
@@ -412,78 +515,57 @@ void AFighterPawn::OnSensitivityDown(const FInputActionValue& Value)
 
 void AFighterPawn::OnPausePressed(const FInputActionValue& Value)
 {
-	if (CurrentGameState == EGameState::Playing)
+	if (GetGameState() == EGameState::Playing)
 	{
-		CurrentGameState = EGameState::Paused;
+		SetGameState(EGameState::Paused);
 		UE_LOG(LogTemp, Log, TEXT("FighterPawn: Game PAUSED"));
 	}
 }
 
 void AFighterPawn::OnDebugTestWave(const FInputActionValue& Value)
 {
-	if (CurrentGameState != EGameState::Playing) return;
+	if (GetGameState() != EGameState::Playing) return;
 
 	UE_LOG(LogTemp, Warning, TEXT("FighterPawn: DEBUG - Destroying all enemies except one of each type"));
 
-	TArray<ATankAI*> AllTanks;
-	for (TActorIterator<ATankAI> It(GetWorld()); It; ++It)
-	{
-		AllTanks.Add(*It);
-	}
-
-	for (int32 i = 1; i < AllTanks.Num(); i++)
-	{
-		if (AllTanks[i] && AllTanks[i]->IsValidLowLevel())
-		{
-			AllTanks[i]->Destroy();
-		}
-	}
-
-	TArray<AHeliAI*> AllHelis;
-	for (TActorIterator<AHeliAI> It(GetWorld()); It; ++It)
-	{
-		AllHelis.Add(*It);
-	}
-
-	for (int32 i = 1; i < AllHelis.Num(); i++)
-	{
-		if (AllHelis[i] && AllHelis[i]->IsValidLowLevel())
-		{
-			AllHelis[i]->Destroy();
-		}
-	}
+	UEnemyRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UEnemyRegistrySubsystem>();
+	if (!Registry) return;
 
-	TArray<AUFOAI*> AllUFOs;
-	for (TActorIterator<AUFOAI> It(GetWorld()); It; ++It)
-	{
-		AllUFOs.Add(*It);
-	}
+	UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>();
+	if (!Kills) return;
 
-	for (int32 i = 1; i < AllUFOs.Num(); i++)
+	// Kills resolve later in the frame, so the registry lists can be walked directly
+	int32 NumDestroyed[NumEnemyTypes] = {};
+	for (int32 TypeIndex = 0; TypeIndex < NumEnemyTypes; ++TypeIndex)
 	{
-		if (AllUFOs[i] && AllUFOs[i]->IsValidLowLevel())
+		const TArray<TObjectPtr<APawn>>& Enemies = Registry->GetEnemies(static_cast<EEnemyType>(TypeIndex));
+		for (int32 i = 1; i < Enemies.Num(); i++)
 		{
-			AllUFOs[i]->Destroy();
+			if (Kills->RequestKill(Enemies[i]))
+			{
+				++NumDestroyed[TypeIndex];
+			}
 		}
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("FighterPawn: DEBUG - Kept 1 of each type. Destroyed %d tanks, %d helis, %d UFOs."), 
-		FMath::Max(0, AllTanks.Num() - 1), FMath::Max(0, AllHelis.Num() - 1),
-		FMath::Max(0, AllUFOs.Num() - 1));
+	UE_LOG(LogTemp, Warning, TEXT("FighterPawn: DEBUG - Kept 1 of each type. Destroyed %d tanks, %d helis, %d UFOs."),
+		NumDestroyed[static_cast<int32>(EEnemyType::Tank)], NumDestroyed[static_cast<int32>(EEnemyType::Heli)],
+		NumDestroyed[static_cast<int32>(EEnemyType::UFO)]);
 }
 
 void AFighterPawn::OnContinuePressed(const FInputActionValue& Value)
 {
-	if (CurrentGameState == EGameState::Instructions || CurrentGameState == EGameState::WaveEnd)
+	const EGameState State = GetGameState();
+	if (State == EGameState::Instructions || State == EGameState::WaveEnd)
 	{
 		StartNextWave();
 	}
-	else if (CurrentGameState == EGameState::Paused)
+	else if (State == EGameState::Paused)
 	{
-		CurrentGameState = EGameState::Playing;
+		SetGameState(EGameState::Playing);
 		UE_LOG(LogTemp, Log, TEXT("FighterPawn: Game RESUMED"));
 	}
-	else if (CurrentGameState == EGameState::GameOver)
+	else if (State == EGameState::GameOver)
 	{
 		UGameplayStatics::OpenLevel(GetWorld(), FName(*GetWorld()->GetName()));
 	}
@@ -491,7 +573,7 @@ void AFighterPawn::OnContinuePressed(const FInputActionValue& Value)
 
 void AFighterPawn::OnQuitGame(const FInputActionValue& Value)
 {
-	if (CurrentGameState == EGameState::Paused)
+	if (GetGameState() == EGameState::Paused)
 	{
 		UE_LOG(LogTemp, Log, TEXT("FighterPawn: Quitting game"));
 		UKismetSystemLibrary::QuitGame(GetWorld(), Cast<APlayerController>(Controller), EQuitPreference::Quit, false);
@@ -504,17 +586,59 @@ void AFighterPawn::OnFpsToggle(const FInputActionValue& Value)
 	UE_LOG(LogTemp, Log, TEXT("FighterPawn: FPS display %s"), bShowFps ? TEXT("ENABLED") : TEXT("DISABLED"));
 }
 
+EGameState AFighterPawn::GetGameState() const
+{
+	const UWorld* World = GetWorld();
+	const UGamePhaseSubsystem* GamePhase = World ? World->GetSubsystem<UGamePhaseSubsystem>() : nullptr;
+	return GamePhase ? GamePhase->GetPhase() : EGameState::Instructions;
+}
+
+void AFighterPawn::SetGameState(EGameState NewState)
+{
+	if (UGamePhaseSubsystem* GamePhase = GetWorld()->GetSubsystem<UGamePhaseSubsystem>())
+	{
+		GamePhase->SetPhase(NewState);
+	}
+}
+
 void AFighterPawn::DamageBase(int32 Damage)
 {
-	if (CurrentGameState != EGameState::Playing) return;
+	if (UBaseDamageSubsystem* BaseDamage = GetWorld()->GetSubsystem<UBaseDamageSubsystem>())
+	{
+		BaseDamage->QueueDamage(Damage);
+	}
+}
+
+void AFighterPawn::ApplyQueuedBaseDamage()
+{
+	UBaseDamageSubsystem* BaseDamage = GetWorld()->GetSubsystem<UBaseDamageSubsystem>();
+	if (!BaseDamage)
+	{
+		return;
+	}
+
+	// Always drain so hits queued outside of play don't land later
+	const FBaseDamageFrame Frame = BaseDamage->Drain();
+	if (!Frame.HasDamage() || GetGameState() != EGameState::Playing) return;
+
+	for (int32 Type = 0; Type < NumEnemyTypes; Type++)
+	{
+		WaveBaseDamageByType[Type] += Frame.DamageByType[Type];
+	}
+	LastFrameBaseDamage = Frame.TotalDamage;
 
-	BaseHP = FMath::Max(0, BaseHP - Damage);
+	BaseHP = FMath::Max(0, BaseHP - Frame.TotalDamage);
 	DamageFlashAlpha = 0.6f;
-	UE_LOG(LogTemp, Log, TEXT("FighterPawn: Base hit! HP: %d/%d"), BaseHP, BaseMaxHP);
+	UE_LOG(LogTemp, Log, TEXT("FighterPawn: Base hit x%d for %d damage (Tanks: %d, Helis: %d, UFOs: %d)! HP: %d/%d"),
+		Frame.NumHits, Frame.TotalDamage,
+		Frame.DamageByType[static_cast<int32>(EEnemyType::Tank)],
+		Frame.DamageByType[static_cast<int32>(EEnemyType::Heli)],
+		Frame.DamageByType[static_cast<int32>(EEnemyType::UFO)],
+		BaseHP, BaseMaxHP);
 
 	if (BaseHP <= 0)
 	{
-		CurrentGameState = EGameState::GameOver;
+		SetGameState(EGameState::GameOver);
 		UE_LOG(LogTemp, Warning, TEXT("FighterPawn: GAME OVER - Base destroyed!"));
 	}
 }
@@ -529,7 +653,7 @@ void AFighterPawn::RegisterWaveEnemies(int32 Tanks, int32 Helis, int32 UFOs)
 
 void AFighterPawn::CheckWaveCleared()
 {
-	if (CurrentGameState != EGameState::Playing) return;
+	if (GetGameState() != EGameState::Playing) return;
 
 	int32 TotalKilled = WaveTanksDestroyed + WaveHelisDestroyed + WaveUFOsDestroyed;
 	int32 TotalEnemies = WaveTotalTanks + WaveTotalHelis + WaveTotalUFOs;
@@ -537,7 +661,7 @@ void AFighterPawn::CheckWaveCleared()
 	if (TotalEnemies > 0 && TotalKilled >= TotalEnemies)
 	{
 		WaveDuration = GetWorld()->GetTimeSeconds() - WaveStartTime;
-		CurrentGameState = EGameState::WaveEnd;
+		SetGameState(EGameState::WaveEnd);
 		UE_LOG(LogTemp, Log, TEXT("FighterPawn: Wave %d cleared in %.1f seconds!"), CurrentWave, WaveDuration);
 	}
 }
@@ -555,9 +679,11 @@ void AFighterPawn::StartNextWave()
 	
 	// Reset base HP at the start of each wave
 	BaseHP = BaseMaxHP;
+	FMemory::Memzero(WaveBaseDamageByType, sizeof(WaveBaseDamageByType));
+	LastFrameBaseDamage = 0;
 	UE_LOG(LogTemp, Log, TEXT("FighterPawn: Base HP reset to %d for wave %d"), BaseHP, CurrentWave);
 
-	CurrentGameState = EGameState::Playing;
+	SetGameState(EGameState::Playing);
 
 	// Find spawners and trigger them
 	for (TActorIterator<ATankWaveSpawner> It(GetWorld()); It; ++It)
@@ -645,11 +771,22 @@ void AFighterPawn::UpdateMouseAim()
 	FVector TraceStart = WorldLocation;
 	FVector TraceEnd = WorldLocation + (WorldDirection * CrosshairMaxDistance);
 
+	// Enemies come from the spatial grid; the trace only has to find terrain in front of the nearest one
+	if (UEnemySpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UEnemySpatialGridSubsystem>())
+	{
+		TArray<FEnemyHandle> EnemiesOnRay;
+		SpatialGrid->QuerySegment(TraceStart, TraceEnd, CrosshairEnemyRadius, EnemiesOnRay);
+		if (EnemiesOnRay.Num() > 0)
+		{
+			TraceEnd = SpatialGrid->GetLocation(EnemiesOnRay[0]);
+		}
+	}
+
 	FHitResult HitResult;
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(this);
 
-	if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility, QueryParams))
+	if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic, QueryParams))
 	{
 		RocketAimWorldTarget = HitResult.ImpactPoint;
 	}
@@ -661,13 +798,62 @@ void AFighterPawn::UpdateMouseAim()
 
 // ==================== Weapons ====================
 
-void AFighterPawn::FireRocket()
+void AFighterPawn::UpdateAutoFire()
+{
+	if (!RocketClass) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// A new burst fires as soon as the cooldown since the last shot allows, with no backlog
+	if (!bRocketBurstActive)
+	{
+		NextRocketFireTime = FMath::Max(NextRocketFireTime, Now);
+		RocketRateWindowStart = NextRocketFireTime;
+		RocketRateWindowShots = 0;
+		bRocketBurstActive = true;
+	}
+
+	int32 NumFired = 0;
+	while (NextRocketFireTime <= Now)
+	{
+		if (NumFired == MaxRocketsPerFrame)
+		{
+			NextRocketFireTime = Now + RocketCooldown;
+			break;
+		}
+
+		FireRocket(NextRocketFireTime);
+		RecordRocketShot(Now);
+		NextRocketFireTime += RocketCooldown;
+		++NumFired;
+	}
+}
+
+void AFighterPawn::RecordRocketShot(double EmitTime)
+{
+	// Measured over whole intervals between emitted shots, so frame quantization shows up here
+	if (RocketRateWindowShots == 0)
+	{
+		RocketRateWindowStart = EmitTime;
+	}
+	else if (EmitTime - RocketRateWindowStart >= RocketRateWindowSeconds)
+	{
+		const float ShotsPerSecond = static_cast<float>(RocketRateWindowShots / (EmitTime - RocketRateWindowStart));
+		SET_FLOAT_STAT(STAT_RocketsPerSecond, ShotsPerSecond);
+		SET_FLOAT_STAT(STAT_RocketCadenceError, (ShotsPerSecond * RocketCooldown - 1.0f) * 100.0f);
+
+		RocketRateWindowStart = EmitTime;
+		RocketRateWindowShots = 0;
+	}
+	++RocketRateWindowShots;
+}
+
+void AFighterPawn::FireRocket(double FireTime)
 {
 	if (!RocketClass) return;
 
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	if (CurrentTime - LastRocketFireTime < RocketCooldown) return;
-	LastRocketFireTime = CurrentTime;
+	// How long ago this shot was owed; it has been flying for that long already
+	const float ShotAge = static_cast<float>(FMath::Max(0.0, GetWorld()->GetTimeSeconds() - FireTime));
 
 	FVector SpawnLocation = GetActorLocation() + GetActorTransform().TransformVector(RocketSpawnOffset);
 
@@ -679,6 +865,32 @@ void AFighterPawn::FireRocket()
 		Direction = GetActorForwardVector();
 	}
 
+	// Actorless rockets are just data in the projectile simulation
+	UProjectileSubsystem* Projectiles = GetWorld()->GetSubsystem<UProjectileSubsystem>();
+	if (bUseActorlessRockets && Projectiles && Projectiles->IsConfigured())
+	{
+		Projectiles->Fire(SpawnLocation, Direction, FireTime);
+		UE_LOG(LogTemp, Log, TEXT("FighterPawn: Rocket fired toward %s"), *RocketAimWorldTarget.ToString());
+		return;
+	}
+
+	// Rocket actors start ahead on their path by the shot's age
+	if (const ARocketProjectile* RocketDefaults = Cast<ARocketProjectile>(RocketClass->GetDefaultObject()))
+	{
+		SpawnLocation += Direction * RocketDefaults->GetRocketSpeed() * ShotAge;
+	}
+
+	// Rocket projectiles are recycled through the pool; other classes are spawned as before
+	URocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<URocketPoolSubsystem>();
+	if (RocketPool && RocketClass->IsChildOf<ARocketProjectile>())
+	{
+		if (RocketPool->Acquire(TSubclassOf<ARocketProjectile>(RocketClass.Get()), SpawnLocation, Direction, this))
+		{
+			UE_LOG(LogTemp, Log, TEXT("FighterPawn: Rocket fired toward %s"), *RocketAimWorldTarget.ToString());
+		}
+		return;
+	}
+
 	FRotator SpawnRotation = Direction.Rotation();
 
 	FActorSpawnParameters SpawnParams;
@@ -700,63 +912,23 @@ void AFighterPawn::FireRocket()
 
 // ==================== Score Tracking ====================
 
-void AFighterPawn::BindEnemyDestroyedEvents()
+void AFighterPawn::OnEnemiesKilled(const FEnemyKillBatch& Batch)
 {
-	if (!GetWorld()) return;
-
-	// Bind to all TankAI actors
-	for (TActorIterator<ATankAI> It(GetWorld()); It; ++It)
-	{
-		AActor* Tank = *It;
-		if (!BoundEnemies.Contains(Tank))
-		{
-			Tank->OnDestroyed.AddDynamic(this, &AFighterPawn::OnEnemyDestroyed);
-			BoundEnemies.Add(Tank);
-		}
-	}
-
-	// Bind to all HeliAI actors
-	for (TActorIterator<AHeliAI> It(GetWorld()); It; ++It)
-	{
-		AActor* Heli = *It;
-		if (!BoundEnemies.Contains(Heli))
-		{
-			Heli->OnDestroyed.AddDynamic(this, &AFighterPawn::OnEnemyDestroyed);
-			BoundEnemies.Add(Heli);
-		}
-	}
+	const int32 Tanks = Batch.GetNumKills(EEnemyType::Tank);
+	const int32 Helis = Batch.GetNumKills(EEnemyType::Heli);
+	const int32 UFOs = Batch.GetNumKills(EEnemyType::UFO);
 
-	// Bind to all UFOAI actors
-	for (TActorIterator<AUFOAI> It(GetWorld()); It; ++It)
-	{
-		AActor* UFO = *It;
-		if (!BoundEnemies.Contains(UFO))
-		{
-			UFO->OnDestroyed.AddDynamic(this, &AFighterPawn::OnEnemyDestroyed);
-			BoundEnemies.Add(UFO);
-		}
-	}
-}
+	WaveTanksDestroyed += Tanks;
+	TotalTanksDestroyed += Tanks;
+	WaveHelisDestroyed += Helis;
+	TotalHelisDestroyed += Helis;
+	WaveUFOsDestroyed += UFOs;
+	TotalUFOsDestroyed += UFOs;
 
-void AFighterPawn::OnEnemyDestroyed(AActor* DestroyedActor)
-{
-	BoundEnemies.Remove(DestroyedActor);
+	UE_LOG(LogTemp, Log, TEXT("FighterPawn: Destroyed %d tanks, %d helis, %d UFOs. Wave: %d/%d tanks, %d/%d helis, %d/%d UFOs"),
+		Tanks, Helis, UFOs, WaveTanksDestroyed, WaveTotalTanks, WaveHelisDestroyed, WaveTotalHelis, WaveUFOsDestroyed, WaveTotalUFOs);
 
-	if (DestroyedActor->IsA<ATankAI>())
-	{
-		AddTankKill();
-		UE_LOG(LogTemp, Log, TEXT("FighterPawn: Tank destroyed! Wave: %d/%d"), WaveTanksDestroyed, WaveTotalTanks);
-	}
-	else if (DestroyedActor->IsA<AHeliAI>())
-	{
-		AddHeliKill();
-		UE_LOG(LogTemp, Log, TEXT("FighterPawn: Helicopter destroyed! Wave: %d/%d"), WaveHelisDestroyed, WaveTotalHelis);
-	}
-	else if (DestroyedActor->IsA<AUFOAI>())
-	{
-		AddUFOKill();
-		UE_LOG(LogTemp, Log, TEXT("FighterPawn: UFO destroyed! Wave: %d/%d"), WaveUFOsDestroyed, WaveTotalUFOs);
-	}
+	CheckWaveCleared();
 }
 
 // ==================== Landscape Streaming ====================
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 #include "InputActionValue.h"
+#include "GamePhaseSubsystem.h"
+#include "EnemyTypes.h"
 #include "FighterPawn.generated.h"
 
 class UCameraComponent;
@@ -12,17 +14,7 @@ class USceneComponent;
 class UInputMappingContext;
 class UInputAction;
 class USoundBase;
-
-/** Game state for managing screens and flow */
-UENUM(BlueprintType)
-enum class EGameState : uint8
-{
-	Instructions,
-	Playing,
-	Paused,
-	WaveEnd,
-	GameOver
-};
+struct FEnemyKillBatch;
 
 /**
  * Turret defense pawn. Fixed at position (0,0,TurretHeight).
@@ -91,7 +83,7 @@ public:
 
 	/** Returns current game state */
 	UFUNCTION(BlueprintCallable, Category = "Game")
-	EGameState GetGameState() const { return CurrentGameState; }
+	EGameState GetGameState() const;
 
 	/** Returns current wave number */
 	UFUNCTION(BlueprintCallable, Category = "Game")
@@ -109,10 +101,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game")
 	float GetWaveDuration() const { return WaveDuration; }
 
-	/** Called by enemies when they shoot the base */
+	/** Queue damage to the base (applied with the rest of the frame's hits on the next Tick) */
 	UFUNCTION(BlueprintCallable, Category = "Game")
 	void DamageBase(int32 Damage = 1);
 
+	/** Returns damage dealt to the base this wave by one enemy type */
+	UFUNCTION(BlueprintCallable, Category = "Game")
+	int32 GetWaveBaseDamage(EEnemyType Source) const { return WaveBaseDamageByType[static_cast<int32>(Source)]; }
+
+	/** Returns total damage dealt to the base during the last frame it was hit */
+	UFUNCTION(BlueprintCallable, Category = "Game")
+	int32 GetLastFrameBaseDamage() const { return LastFrameBaseDamage; }
+
 	/** Called by spawners to register wave enemy counts */
 	void RegisterWaveEnemies(int32 Tanks, int32 Helis, int32 UFOs = 0);
 
@@ -143,6 +143,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -220,6 +221,18 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket", meta = (ClampMin = "0.01"))
 	float RocketCooldown = 0.15f;
 
+	/** Rockets and rocket trails spawned into their pools at BeginPlay (the pools still grow past this if needed) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket", meta = (ClampMin = "0"))
+	int32 RocketPoolPrewarmCount = 24;
+
+	/** Dormant explosion actors spawned into their recycling pool at BeginPlay (the pool grows past this after big bursts) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Explosion", meta = (ClampMin = "0"))
+	int32 ExplosionPoolPrewarmCount = 16;
+
+	/** Simulate rockets as plain data with swept hit tests and instanced visuals instead of actors */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket")
+	bool bUseActorlessRockets = true;
+
 	/** Offset from pawn origin where rockets spawn (local space).
 	 *  Positive X = forward, negative Z = below camera. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket")
@@ -229,6 +242,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket", meta = (ClampMin = "1000.0"))
 	float CrosshairMaxDistance = 50000.0f;
 
+	/** How close to the crosshair ray an enemy's center must be to snap the aim onto it (units) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket", meta = (ClampMin = "0.0"))
+	float CrosshairEnemyRadius = 150.0f;
+
 	// ==================== Enhanced Input ====================
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
@@ -282,8 +299,17 @@ private:
 	/** Current height input: -1 = Q (down), +1 = E (up), 0 = none */
 	float HeightInput = 0.0f;
 
-	/** Time when last rocket was fired */
-	float LastRocketFireTime = -999.0f;
+	/** World time the next auto-fire shot is owed at; every shot due within a frame is emitted */
+	double NextRocketFireTime = 0.0;
+
+	/** Set while a held-fire burst is running (the accumulator only carries over within a burst) */
+	bool bRocketBurstActive = false;
+
+	/** Emission time of the first shot in the current fire-rate measurement window */
+	double RocketRateWindowStart = 0.0;
+
+	/** Shots emitted since the window started */
+	int32 RocketRateWindowShots = 0;
 
 	/** Whether fire button is held */
 	bool bFireRocketHeld = false;
@@ -316,14 +342,21 @@ private:
 	int32 TotalHelisDestroyed = 0;
 	int32 TotalUFOsDestroyed = 0;
 
-	/** Game state */
-	EGameState CurrentGameState = EGameState::Instructions;
+	/** Game state (owned by UGamePhaseSubsystem) */
+	void SetGameState(EGameState NewState);
 	int32 CurrentWave = 0;
 
 	/** Base HP */
 	int32 BaseHP = 100;
 	int32 BaseMaxHP = 100;
 
+	/** Base damage telemetry */
+	int32 WaveBaseDamageByType[NumEnemyTypes] = {};
+	int32 LastFrameBaseDamage = 0;
+
+	/** Apply all hits queued on UBaseDamageSubsystem since the last frame */
+	void ApplyQueuedBaseDamage();
+
 	/** Damage flash */
 	float DamageFlashAlpha = 0.0f;
 	float DamageFlashDecayRate = 3.0f;
@@ -379,12 +412,6 @@ private:
 	float RadarZoomMin = 0.2f;
 	float RadarZoomMax = 3.0f;
 
-	/** Timer for periodic enemy scanning */
-	float EnemyScanTimer = 0.0f;
-
-	/** Set of enemies we've already bound OnDestroyed to (avoid double-binding) */
-	TSet<AActor*> BoundEnemies;
-
 	/** Cached mouse delta for current frame */
 	float FrameMouseDeltaX = 0.0f;
 	float FrameMouseDeltaY = 0.0f;
@@ -428,14 +455,29 @@ private:
 	void UpdateTurretAim(float DeltaTime);
 	void UpdateTurretHeight(float DeltaTime);
 	void UpdateMouseAim();
-	void FireRocket();
-	void BindEnemyDestroyedEvents();
+	/** Emit every auto-fire shot owed up to now */
+	void UpdateAutoFire();
+
+	/**
+	 * Fire one rocket.
+	 * @param FireTime - World time the shot was owed at; the rocket starts as far along its path as it would have flown since then
+	 */
+	void FireRocket(double FireTime);
+
+	/** Feed the shots-per-second and cadence error stats */
+	void RecordRocketShot(double EmitTime);
 	void CheckWaveCleared();
 	void StartNextWave();
 	void ApplyZoomToCamera();
 
-	UFUNCTION()
-	void OnEnemyDestroyed(AActor* DestroyedActor);
+	/** Push SoundVolume to the weapon audio subsystem's cached setting */
+	void PublishSoundVolume() const;
+
+	/** Create the batched explosion component an enemy class's explosion config uses, if any */
+	void PrewarmBatchedExplosion(const UClass* EnemyClass) const;
+
+	/** Bound to the kill subsystem; counts a frame's kills for the current wave */
+	void OnEnemiesKilled(const FEnemyKillBatch& Batch);
 
 	// ==================== Landscape Streaming ====================
 
@@ -0,0 +1,19 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GamePhaseSubsystem.h"
+
+void UGamePhaseSubsystem::SetPhase(EGameState NewPhase)
+{
+	if (NewPhase == Phase)
+	{
+		return;
+	}
+
+	const EGameState OldPhase = Phase;
+	Phase = NewPhase;
+
+	UE_LOG(LogTemp, Log, TEXT("GamePhase: %s -> %s"),
+		*UEnum::GetValueAsString(OldPhase), *UEnum::GetValueAsString(NewPhase));
+
+	OnPhaseChanged.Broadcast(OldPhase, NewPhase);
+}
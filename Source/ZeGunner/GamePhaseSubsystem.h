@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GamePhaseSubsystem.generated.h"
+
+/** Game state for managing screens and flow */
+UENUM(BlueprintType)
+enum class EGameState : uint8
+{
+	Instructions,
+	Playing,
+	Paused,
+	WaveEnd,
+	GameOver
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGamePhaseChanged, EGameState, OldPhase, EGameState, NewPhase);
+
+/**
+ * Owns the current game phase for the world and broadcasts transitions.
+ * Systems that only care about pausing subscribe once instead of polling
+ * the player pawn every frame.
+ */
+UCLASS()
+class ZEGUNNER_API UGamePhaseSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Called after the phase has changed */
+	UPROPERTY(BlueprintAssignable, Category = "Game")
+	FOnGamePhaseChanged OnPhaseChanged;
+
+	/** Current game phase */
+	UFUNCTION(BlueprintPure, Category = "Game")
+	EGameState GetPhase() const { return Phase; }
+
+	/** Is gameplay currently paused? */
+	UFUNCTION(BlueprintPure, Category = "Game")
+	bool IsPaused() const { return Phase == EGameState::Paused; }
+
+	/** Switch phase and broadcast the transition (no-op if unchanged) */
+	UFUNCTION(BlueprintCallable, Category = "Game")
+	void SetPhase(EGameState NewPhase);
+
+private:
+	EGameState Phase = EGameState::Instructions;
+};
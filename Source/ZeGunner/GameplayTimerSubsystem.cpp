@@ -0,0 +1,178 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameplayTimerSubsystem.h"
+#include "ZeGunner.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gameplay Timers"), STAT_GameplayTimers, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timers Expired"), STAT_TimersExpired, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timers Pending"), STAT_TimersPending, STATGROUP_ZeGunner);
+
+void UGameplayTimerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// All timers freeze together while the game is paused
+	if (UGamePhaseSubsystem* GamePhase = Collection.InitializeDependency<UGamePhaseSubsystem>())
+	{
+		GamePhase->OnPhaseChanged.AddDynamic(this, &UGameplayTimerSubsystem::HandlePhaseChanged);
+		bPaused = GamePhase->IsPaused();
+	}
+}
+
+void UGameplayTimerSubsystem::Deinitialize()
+{
+	if (UGamePhaseSubsystem* GamePhase = GetWorld()->GetSubsystem<UGamePhaseSubsystem>())
+	{
+		GamePhase->OnPhaseChanged.RemoveDynamic(this, &UGameplayTimerSubsystem::HandlePhaseChanged);
+	}
+
+	Super::Deinitialize();
+}
+
+bool UGameplayTimerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UGameplayTimerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGameplayTimerSubsystem, STATGROUP_Tickables);
+}
+
+void UGameplayTimerSubsystem::HandlePhaseChanged(EGameState OldPhase, EGameState NewPhase)
+{
+	bPaused = NewPhase == EGameState::Paused;
+}
+
+// ==================== Scheduling ====================
+
+FGameplayTimerHandle UGameplayTimerSubsystem::Schedule(float Delay, FSimpleDelegate&& Callback)
+{
+	FGameplayTimerHandle Handle;
+
+	// Never due in the current tick, which has already been processed
+	const int64 DelayTicks = FMath::Max<int64>(1, FMath::CeilToInt64(FMath::Max(0.0f, Delay) / TickSeconds));
+
+	FTimer Timer;
+	Timer.DueTick = CurrentTick + DelayTicks;
+	Timer.Serial = NextSerial++;
+	Timer.Callback = MoveTemp(Callback);
+
+	Handle.Serial = Timer.Serial;
+	Handle.Index = Timers.Add(MoveTemp(Timer));
+	InsertIntoWheel(Handle.Index);
+
+	return Handle;
+}
+
+void UGameplayTimerSubsystem::Cancel(FGameplayTimerHandle& Handle)
+{
+	if (IsPending(Handle))
+	{
+		// The slot entry goes stale and is skipped when its slot comes up
+		Timers.RemoveAt(Handle.Index);
+	}
+	Handle.Reset();
+}
+
+bool UGameplayTimerSubsystem::IsPending(const FGameplayTimerHandle& Handle) const
+{
+	return Handle.IsValid() && Timers.IsValidIndex(Handle.Index) && Timers[Handle.Index].Serial == Handle.Serial;
+}
+
+void UGameplayTimerSubsystem::InsertIntoWheel(int32 Index)
+{
+	const FTimer& Timer = Timers[Index];
+	const int64 Delta = FMath::Max<int64>(0, Timer.DueTick - CurrentTick);
+
+	// Smallest level whose range covers the delay; anything further out waits in the top level
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && Delta >= (int64(1) << (SlotBits * (Level + 1))))
+	{
+		++Level;
+	}
+
+	// Cascades run before the current tick's slot is processed, so due-now still fires this tick
+	const int64 SlotTick = FMath::Max(Timer.DueTick, CurrentTick);
+	const int32 Slot = static_cast<int32>((SlotTick >> (SlotBits * Level)) & (NumSlots - 1));
+	Wheels[Level][Slot].Add({ Index, Timer.Serial });
+}
+
+// ==================== Tick ====================
+
+void UGameplayTimerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_GameplayTimers);
+
+	NumExpiredLastFrame = 0;
+	ElapsedSeconds += DeltaTime;
+
+	const int64 TargetTick = static_cast<int64>(ElapsedSeconds / TickSeconds);
+	while (CurrentTick < TargetTick)
+	{
+		AdvanceTick();
+	}
+
+	SET_DWORD_STAT(STAT_TimersExpired, NumExpiredLastFrame);
+	SET_DWORD_STAT(STAT_TimersPending, Timers.Num());
+}
+
+void UGameplayTimerSubsystem::Cascade(int32 Level, int32 Slot)
+{
+	TArray<FSlotEntry> Entries = MoveTemp(Wheels[Level][Slot]);
+	Wheels[Level][Slot].Reset();
+
+	for (const FSlotEntry& Entry : Entries)
+	{
+		if (Timers.IsValidIndex(Entry.Index) && Timers[Entry.Index].Serial == Entry.Serial)
+		{
+			InsertIntoWheel(Entry.Index);
+		}
+	}
+}
+
+void UGameplayTimerSubsystem::AdvanceTick()
+{
+	++CurrentTick;
+
+	// When a finer level wraps around, pull the next coarse slot down into it.
+	// Coarsest first, so timers cascading through several levels land in a slot that is still ahead.
+	int32 TopLevel = 0;
+	while (TopLevel < NumLevels - 1 && (CurrentTick & ((int64(1) << (SlotBits * (TopLevel + 1))) - 1)) == 0)
+	{
+		++TopLevel;
+	}
+	for (int32 Level = TopLevel; Level >= 1; --Level)
+	{
+		Cascade(Level, static_cast<int32>((CurrentTick >> (SlotBits * Level)) & (NumSlots - 1)));
+	}
+
+	// Callbacks may schedule new timers into this slot's array, so take it first
+	const int32 Slot = static_cast<int32>(CurrentTick & (NumSlots - 1));
+	TArray<FSlotEntry> Due = MoveTemp(Wheels[0][Slot]);
+	Wheels[0][Slot].Reset();
+
+	for (const FSlotEntry& Entry : Due)
+	{
+		if (!Timers.IsValidIndex(Entry.Index) || Timers[Entry.Index].Serial != Entry.Serial)
+		{
+			continue;
+		}
+
+		// Still a lap or more away (only possible for delays beyond the top level)
+		if (Timers[Entry.Index].DueTick > CurrentTick)
+		{
+			InsertIntoWheel(Entry.Index);
+			continue;
+		}
+
+		FSimpleDelegate Callback = MoveTemp(Timers[Entry.Index].Callback);
+		Timers.RemoveAt(Entry.Index);
+		++NumExpiredLastFrame;
+
+		Callback.ExecuteIfBound();
+	}
+}
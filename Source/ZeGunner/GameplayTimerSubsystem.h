@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GamePhaseSubsystem.h"
+#include "GameplayTimerSubsystem.generated.h"
+
+/** Handle to a timer scheduled on UGameplayTimerSubsystem */
+struct FGameplayTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Reset() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ * One-shot gameplay timers on a hierarchical timing wheel.
+ * Scheduling and cancelling are O(1) and a frame only touches the timers that expire
+ * (plus the occasional cascade of a coarser slot), so thousands of idle countdowns cost nothing.
+ * Time only advances while the game phase isn't Paused, which pauses every timer at once.
+ * Callbacks run on the game thread in due order; same-tick timers fire in scheduling order.
+ */
+UCLASS()
+class ZEGUNNER_API UGameplayTimerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return !bPaused; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Call Callback once, Delay seconds from now (rounded up to the wheel resolution) */
+	FGameplayTimerHandle Schedule(float Delay, FSimpleDelegate&& Callback);
+
+	/** Cancel a pending timer and reset the handle (safe on stale or fired handles) */
+	void Cancel(FGameplayTimerHandle& Handle);
+
+	/** Whether the timer is still waiting to fire */
+	bool IsPending(const FGameplayTimerHandle& Handle) const;
+
+	/** Number of timers that fired during the last tick */
+	int32 GetNumExpiredLastFrame() const { return NumExpiredLastFrame; }
+
+	/** Number of timers waiting to fire */
+	int32 GetNumPending() const { return Timers.Num(); }
+
+private:
+	/** Wheel resolution in seconds */
+	static constexpr double TickSeconds = 1.0 / 120.0;
+
+	/** Each level has 2^SlotBits slots, each slot of level N spans 2^(SlotBits * N) ticks */
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 NumSlots = 1 << SlotBits;
+	static constexpr int32 NumLevels = 4;
+
+	struct FTimer
+	{
+		int64 DueTick = 0;
+		uint32 Serial = 0;
+		FSimpleDelegate Callback;
+	};
+
+	/** Slot entry; stale once the timer's serial no longer matches (cancelled) */
+	struct FSlotEntry
+	{
+		int32 Index;
+		uint32 Serial;
+	};
+
+	TSparseArray<FTimer> Timers;
+	TArray<FSlotEntry> Wheels[NumLevels][NumSlots];
+
+	/** Wheel time, only advanced while not paused */
+	double ElapsedSeconds = 0.0;
+	int64 CurrentTick = 0;
+	uint32 NextSerial = 1;
+
+	int32 NumExpiredLastFrame = 0;
+	bool bPaused = false;
+
+	UFUNCTION()
+	void HandlePhaseChanged(EGameState OldPhase, EGameState NewPhase);
+
+	/** Place a timer in the slot matching how far away it is due */
+	void InsertIntoWheel(int32 Index);
+
+	/** Re-insert every timer of a coarse slot into finer levels */
+	void Cascade(int32 Level, int32 Slot);
+
+	/** Advance one tick and fire what is due */
+	void AdvanceTick();
+};
@@ -1,14 +1,16 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "HeliAI.h"
-#include "FighterPawn.h"
+#include "EnemyMovementSubsystem.h"
+#include "EnemyRegistrySubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SceneComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
 
 AHeliAI::AHeliAI()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Movement is stepped in bulk by UEnemyMovementSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Create explosion component for death effects
 	ExplosionComp = CreateDefaultSubobject<UExplosionComponent>(TEXT("ExplosionComp"));
@@ -21,6 +23,10 @@ AHeliAI::AHeliAI()
 	// Create static mesh component
 	HeliMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("HeliMesh"));
 	HeliMesh->SetupAttachment(RootComponent);
+
+	// The mesh is the helicopter's collision; same Enemy profile as the tank and UFO boxes
+	HeliMesh->SetCollisionProfileName(TEXT("Enemy"));
+	HeliMesh->SetGenerateOverlapEvents(false);
 }
 
 void AHeliAI::BeginPlay()
@@ -33,9 +39,6 @@ void AHeliAI::BeginPlay()
 		SceneRoot->SetMobility(EComponentMobility::Movable);
 	}
 
-	// Store initial spawn location
-	InitialSpawnLocation = GetActorLocation();
-
 	UE_LOG(LogTemp, Log, TEXT("HeliAI: BeginPlay - Location=%s"), *GetActorLocation().ToString());
 
 	// Check and log mesh status
@@ -54,6 +57,29 @@ void AHeliAI::BeginPlay()
 	{
 		UE_LOG(LogTemp, Error, TEXT("HeliAI: ERROR - HeliMesh is NULL!"));
 	}
+
+	// Register with the movement subsystem using the current configuration
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		FEnemyMotionParams Params;
+		Params.TargetLocation = TargetLocation;
+		Params.StoppingDistance = StoppingDistance;
+		Params.RotationSpeed = RotationSpeed;
+		Params.FlyHeight = FlyHeight;
+		Params.RateOfFire = RateOfFire;
+		Params.LateralDanceDistance = LateralDanceDistance;
+		Params.LateralMinSpeed = LateralMinSpeed;
+		Params.LateralMaxSpeed = LateralMaxSpeed;
+		Params.LateralMinTime = LateralMinTime;
+		Params.LateralMaxTime = LateralMaxTime;
+
+		MovementHandle = Movement->RegisterEnemy(this, EEnemyType::Heli, Params, MoveSpeed);
+	}
+
+	if (UEnemyRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UEnemyRegistrySubsystem>())
+	{
+		Registry->RegisterEnemy(this, EEnemyType::Heli);
+	}
 }
 
 void AHeliAI::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -65,74 +91,33 @@ void AHeliAI::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		ExplosionComp->SpawnExplosionAtOwner();
 	}
 
-	Super::EndPlay(EndPlayReason);
-}
-
-void AHeliAI::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	// Don't update AI when game is paused
-	if (IsGamePaused())
-	{
-		return;
-	}
-
-	if (!bTargetSet)
-	{
-		return;
-	}
-
-	// Check if we should start lateral dancing (within dance distance of target)
-	if (!bIsDancing && LateralDanceDistance > 0.0f)
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
 	{
-		float DistToTarget = FVector::Dist2D(GetActorLocation(), TargetLocation);
-		if (DistToTarget <= LateralDanceDistance && DistToTarget > StoppingDistance)
-		{
-			bIsDancing = true;
-			// Calculate lateral axis (perpendicular to approach direction, in XY plane)
-			FVector ToTarget = (TargetLocation - GetActorLocation()).GetSafeNormal2D();
-			LateralAxis = FVector(-ToTarget.Y, ToTarget.X, 0.0f); // 90-degree rotation in XY
-			PickNewLateralLeg();
-			UE_LOG(LogTemp, Log, TEXT("HeliAI: Started lateral dancing at dist %.0f"), DistToTarget);
-		}
+		Movement->UnregisterEnemy(MovementHandle);
 	}
 
-	// Move and rotate toward target
-	MoveTowardTarget(DeltaTime);
-
-	// Apply lateral dancing if active
-	if (bIsDancing && !HasReachedTarget())
+	if (UEnemyRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UEnemyRegistrySubsystem>())
 	{
-		UpdateLateralDance(DeltaTime);
+		Registry->UnregisterEnemy(this);
 	}
 
-	RotateTowardTarget(DeltaTime);
-
-	// Fire at base when stopped at line of fire
-	if (HasReachedTarget() && !bIsFiring)
-	{
-		bIsFiring = true;
-		FireTimer = RateOfFire;
-		UE_LOG(LogTemp, Log, TEXT("HeliAI: Reached target! Starting fire at base. Dist2D=%.1f, StopDist=%.1f"),
-			FVector::Dist2D(GetActorLocation(), TargetLocation), StoppingDistance);
-	}
+	Super::EndPlay(EndPlayReason);
+}
 
-	if (bIsFiring)
-	{
-		FireTimer -= DeltaTime;
-		if (FireTimer <= 0.0f)
-		{
-			FireAtBase();
-			FireTimer = RateOfFire;
-		}
-	}
+UEnemyMovementSubsystem* AHeliAI::GetMovementSubsystem() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UEnemyMovementSubsystem>() : nullptr;
 }
 
 void AHeliAI::SetTargetLocation(const FVector& NewTarget)
 {
 	TargetLocation = NewTarget;
-	bTargetSet = true;
+
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		Movement->SetTargetLocation(MovementHandle, TargetLocation);
+	}
 
 	UE_LOG(LogTemp, Log, TEXT("HeliAI: Target set to %s"), *TargetLocation.ToString());
 }
@@ -140,11 +125,24 @@ void AHeliAI::SetTargetLocation(const FVector& NewTarget)
 void AHeliAI::SetMoveSpeed(float NewSpeed)
 {
 	MoveSpeed = FMath::Max(0.0f, NewSpeed);
+
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		Movement->SetMoveSpeed(MovementHandle, MoveSpeed);
+	}
 }
 
 void AHeliAI::SetStoppingDistance(float NewDistance)
 {
 	StoppingDistance = FMath::Max(0.0f, NewDistance);
+
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		if (FEnemyMotionParams* Params = Movement->GetParams(MovementHandle))
+		{
+			Params->StoppingDistance = StoppingDistance;
+		}
+	}
 }
 
 void AHeliAI::SetMeshRotation(float YawRotation)
@@ -168,11 +166,28 @@ void AHeliAI::SetFlyHeight(float NewHeight)
 	FVector CurrentLocation = GetActorLocation();
 	CurrentLocation.Z = FlyHeight;
 	SetActorLocation(CurrentLocation);
+
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		if (FEnemyMotionParams* Params = Movement->GetParams(MovementHandle))
+		{
+			Params->FlyHeight = FlyHeight;
+		}
+		Movement->SyncFromActor(MovementHandle);
+	}
 }
 
 void AHeliAI::SetRateOfFire(float Rate)
 {
 	RateOfFire = FMath::Max(0.1f, Rate);
+
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		if (FEnemyMotionParams* Params = Movement->GetParams(MovementHandle))
+		{
+			Params->RateOfFire = RateOfFire;
+		}
+	}
 }
 
 void AHeliAI::SetLateralDanceSettings(float DanceDistance, float MinSpeed, float MaxSpeed, float MinTime, float MaxTime)
@@ -182,113 +197,25 @@ void AHeliAI::SetLateralDanceSettings(float DanceDistance, float MinSpeed, float
 	LateralMaxSpeed = MaxSpeed;
 	LateralMinTime = MinTime;
 	LateralMaxTime = MaxTime;
-}
 
-bool AHeliAI::HasReachedTarget() const
-{
-	if (!bTargetSet)
-	{
-		return false;
-	}
-
-	float Distance = FVector::Dist2D(GetActorLocation(), TargetLocation);
-	return Distance <= StoppingDistance;
-}
-
-void AHeliAI::MoveTowardTarget(float DeltaTime)
-{
-	if (HasReachedTarget())
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
 	{
-		return;
-	}
-
-	// Calculate direction to target (only XY, maintain fly height)
-	FVector CurrentLocation = GetActorLocation();
-	FVector TargetAtHeight = TargetLocation;
-	TargetAtHeight.Z = FlyHeight;
-
-	FVector Direction = (TargetAtHeight - CurrentLocation).GetSafeNormal();
-	Direction.Z = 0.0f; // Keep level flight
-
-	// Move the helicopter
-	FVector NewLocation = CurrentLocation + Direction * MoveSpeed * DeltaTime;
-	NewLocation.Z = FlyHeight; // Maintain fly height
-
-	SetActorLocation(NewLocation);
-}
-
-void AHeliAI::FireAtBase()
-{
-	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
-	if (AFighterPawn* Fighter = Cast<AFighterPawn>(PlayerPawn))
-	{
-		Fighter->DamageBase(1);
-	}
-}
-
-void AHeliAI::RotateTowardTarget(float DeltaTime)
-{
-	// Calculate rotation to face the target (only Yaw rotation)
-	FVector CurrentLocation = GetActorLocation();
-	FVector TargetAtHeight = TargetLocation;
-	TargetAtHeight.Z = FlyHeight;
-
-	FVector Direction = (TargetAtHeight - CurrentLocation).GetSafeNormal();
-	Direction.Z = 0.0f;
-
-	if (Direction.IsNearlyZero())
-	{
-		return;
-	}
-
-	FRotator TargetRotation = Direction.Rotation();
-	FRotator CurrentRotation = GetActorRotation();
-
-	// Smoothly interpolate toward target rotation (only Yaw)
-	float NewYaw = FMath::FInterpTo(CurrentRotation.Yaw, TargetRotation.Yaw, DeltaTime, RotationSpeed);
-	SetActorRotation(FRotator(0.0f, NewYaw, 0.0f));
-}
-
-void AHeliAI::UpdateLateralDance(float DeltaTime)
-{
-	// Count down timer
-	LateralTimer -= DeltaTime;
-	if (LateralTimer <= 0.0f)
-	{
-		PickNewLateralLeg();
+		if (FEnemyMotionParams* Params = Movement->GetParams(MovementHandle))
+		{
+			Params->LateralDanceDistance = LateralDanceDistance;
+			Params->LateralMinSpeed = LateralMinSpeed;
+			Params->LateralMaxSpeed = LateralMaxSpeed;
+			Params->LateralMinTime = LateralMinTime;
+			Params->LateralMaxTime = LateralMaxTime;
+		}
 	}
-
-	// Move laterally
-	FVector CurrentLocation = GetActorLocation();
-	FVector LateralOffset = LateralAxis * LateralDirection * CurrentLateralSpeed * DeltaTime;
-	LateralOffset.Z = 0.0f;
-	FVector NewLocation = CurrentLocation + LateralOffset;
-	NewLocation.Z = FlyHeight;
-	SetActorLocation(NewLocation);
-}
-
-void AHeliAI::PickNewLateralLeg()
-{
-	// Flip direction
-	LateralDirection = -LateralDirection;
-
-	// Random speed and duration for this leg
-	CurrentLateralSpeed = FMath::FRandRange(LateralMinSpeed, LateralMaxSpeed);
-	LateralTimer = FMath::FRandRange(LateralMinTime, LateralMaxTime);
 }
 
-bool AHeliAI::IsGamePaused() const
+bool AHeliAI::HasReachedTarget() const
 {
-	// Get the player pawn and check if game is paused
-	if (UWorld* World = GetWorld())
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
 	{
-		if (APlayerController* PC = World->GetFirstPlayerController())
-		{
-			if (AFighterPawn* Fighter = Cast<AFighterPawn>(PC->GetPawn()))
-			{
-				return Fighter->GetGameState() == EGameState::Paused;
-			}
-		}
+		return Movement->HasReachedTarget(MovementHandle);
 	}
 	return false;
 }
@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 #include "ExplosionComponent.h"
-#include "FighterPawn.h"
+#include "EnemyTypes.h"
 #include "HeliAI.generated.h"
 
+class UEnemyMovementSubsystem;
+
 UCLASS()
 class ZEGUNNER_API AHeliAI : public APawn
 {
@@ -22,7 +24,6 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** The static mesh component for the helicopter */
@@ -93,22 +94,10 @@ public:
 	bool HasReachedTarget() const;
 
 private:
-	/** Initial spawn position for reference */
-	FVector InitialSpawnLocation;
-
-	/** Has a target been explicitly set? */
-	bool bTargetSet = false;
-
-	/** Whether this heli has reached the line of fire and is shooting */
-	bool bIsFiring = false;
-
 	/** Seconds between shots at the base */
 	float RateOfFire = 3.0f;
 
-	/** Timer counting down to next shot */
-	float FireTimer = 0.0f;
-
-	// ==================== Lateral Dancing State ====================
+	// ==================== Lateral Dancing Settings ====================
 
 	/** Distance from base where lateral dancing begins */
 	float LateralDanceDistance = 1000.0f;
@@ -125,36 +114,9 @@ private:
 	/** Maximum time moving in one lateral direction (seconds) */
 	float LateralMaxTime = 2.0f;
 
-	/** Whether lateral dancing is currently active */
-	bool bIsDancing = false;
-
-	/** Current lateral direction: 1 = left, -1 = right */
-	int32 LateralDirection = 1;
-
-	/** Current lateral speed for this dance leg */
-	float CurrentLateralSpeed = 0.0f;
-
-	/** Timer counting down until next direction change */
-	float LateralTimer = 0.0f;
-
-	/** The lateral axis (perpendicular to approach direction) */
-	FVector LateralAxis = FVector::ZeroVector;
-
-	/** Move the helicopter toward target */
-	void MoveTowardTarget(float DeltaTime);
-
-	/** Perform lateral dancing movement */
-	void UpdateLateralDance(float DeltaTime);
-
-	/** Pick a new random lateral direction, speed, and duration */
-	void PickNewLateralLeg();
-
-	/** Smoothly rotate toward target */
-	void RotateTowardTarget(float DeltaTime);
-
-	/** Fire at the base (damage it) */
-	void FireAtBase();
+	/** Slot in the enemy movement subsystem (movement state lives there) */
+	FEnemyHandle MovementHandle;
 
-	/** Check if the game is currently paused */
-	bool IsGamePaused() const;
+	/** Get the movement subsystem for this world */
+	UEnemyMovementSubsystem* GetMovementSubsystem() const;
 };
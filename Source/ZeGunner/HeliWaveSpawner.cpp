@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "HeliWaveSpawner.h"
+#include "EnemyKillSubsystem.h"
 #include "HeliAI.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
@@ -18,6 +19,22 @@ void AHeliWaveSpawner::BeginPlay()
 	Super::BeginPlay();
 
 	UE_LOG(LogTemp, Log, TEXT("HeliWaveSpawner: Base target is world origin (0,0,0). Waiting for command to spawn."));
+
+	// Kills arrive in one batch per frame; our enemies are the ones we own
+	if (UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>())
+	{
+		Kills->OnEnemiesKilled.AddUObject(this, &AHeliWaveSpawner::OnEnemiesKilled);
+	}
+}
+
+void AHeliWaveSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>())
+	{
+		Kills->OnEnemiesKilled.RemoveAll(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AHeliWaveSpawner::TriggerNextWave()
@@ -77,6 +94,7 @@ void AHeliWaveSpawner::SpawnWave()
 
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		SpawnParams.Owner = this;
 
 		APawn* SpawnedHeli = GetWorld()->SpawnActor<APawn>(HeliClass, SpawnLocation, SpawnRotation, SpawnParams);
 
@@ -99,9 +117,6 @@ void AHeliWaveSpawner::SpawnWave()
 				HeliAI->SetTargetLocation(TargetLocation);
 			}
 
-			// Bind to destruction event
-			SpawnedHeli->OnDestroyed.AddDynamic(this, &AHeliWaveSpawner::OnHeliDestroyed);
-
 			ActiveHeliCount++;
 
 			UE_LOG(LogTemp, Log, TEXT("HeliWaveSpawner: Spawned helicopter %d/%d at %s with speed %.1f"),
@@ -161,10 +176,20 @@ FVector AHeliWaveSpawner::GetRandomSpawnPosition(float Radius)
 	return FVector::ZeroVector;
 }
 
-void AHeliWaveSpawner::OnHeliDestroyed(AActor* DestroyedActor)
+void AHeliWaveSpawner::OnEnemiesKilled(const FEnemyKillBatch& Batch)
 {
-	ActiveHeliCount--;
-	UE_LOG(LogTemp, Log, TEXT("HeliWaveSpawner: Helicopter destroyed. Active helicopters remaining: %d"), ActiveHeliCount);
+	int32 NumKilled = 0;
+	for (const APawn* Victim : Batch.Victims)
+	{
+		NumKilled += Victim->GetOwner() == this ? 1 : 0;
+	}
+	if (NumKilled == 0)
+	{
+		return;
+	}
+
+	ActiveHeliCount -= NumKilled;
+	UE_LOG(LogTemp, Log, TEXT("HeliWaveSpawner: Helicopters destroyed: %d. Active remaining: %d"), NumKilled, ActiveHeliCount);
 
 	CheckWaveComplete();
 }
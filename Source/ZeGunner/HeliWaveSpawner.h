@@ -7,6 +7,8 @@
 #include "HeliAI.h"
 #include "HeliWaveSpawner.generated.h"
 
+struct FEnemyKillBatch;
+
 UCLASS()
 class ZEGUNNER_API AHeliWaveSpawner : public AActor
 {
@@ -27,8 +29,12 @@ public:
 	/** Returns how many helis will spawn in the next wave */
 	int32 GetNextWaveHeliCount() const { return HelisPerWave + CurrentWave * HelisAddedPerWave; }
 
+	/** Class this spawner spawns helis of */
+	TSubclassOf<class AHeliAI> GetHeliClass() const { return HeliClass; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
 	/** The class to spawn for helicopters (should be a Blueprint based on HeliAI) */
@@ -157,9 +163,8 @@ private:
 	/** Calculate a random spawn position on the circle that doesn't overlap with others */
 	FVector GetRandomSpawnPosition(float Radius);
 
-	/** Called when a helicopter is destroyed */
-	UFUNCTION()
-	void OnHeliDestroyed(AActor* DestroyedActor);
+	/** Bound to the kill subsystem; drops this spawner's victims from the active count */
+	void OnEnemiesKilled(const FEnemyKillBatch& Batch);
 
 	/** Start the next wave timer */
 	void ScheduleNextWave();
@@ -0,0 +1,396 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectileSubsystem.h"
+#include "EnemySpatialGridSubsystem.h"
+#include "EnemyMovementSubsystem.h"
+#include "AreaDamageSubsystem.h"
+#include "TankAI.h"
+#include "HeliAI.h"
+#include "ZeGunner.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "TrailPoolSubsystem.h"
+#include "WeaponAudioSubsystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Step"), STAT_ProjectileStep, STATGROUP_ZeGunner);
+DECLARE_CYCLE_STAT(TEXT("Projectile Hit Resolve"), STAT_ProjectileHitResolve, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Active"), STAT_ProjectilesActive, STATGROUP_ZeGunner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Sweeps Submitted"), STAT_ProjectileSweepsSubmitted, STATGROUP_ZeGunner);
+
+static TAutoConsoleVariable<int32> CVarProjectileAsyncSweeps(
+	TEXT("ZeGunner.Projectile.AsyncSweeps"),
+	1,
+	TEXT("Submit projectile terrain sweeps as async traces and apply hits at the start of the next frame (0 = synchronous traces)."),
+	ECVF_Default);
+
+bool UProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Setup ====================
+
+void UProjectileSubsystem::Configure(TSubclassOf<ARocketProjectile> InRocketClass)
+{
+	UWorld* World = GetWorld();
+	if (!World || !InRocketClass)
+	{
+		return;
+	}
+
+	RocketClass = InRocketClass;
+	FlightParams = GetDefault<ARocketProjectile>(RocketClass)->GetFlightParams();
+
+	if (!VisualsActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		VisualsActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!VisualsActor)
+		{
+			return;
+		}
+
+		Instances = NewObject<UInstancedStaticMeshComponent>(VisualsActor, TEXT("RocketInstances"));
+		Instances->SetMobility(EComponentMobility::Movable);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCastShadow(false);
+		VisualsActor->SetRootComponent(Instances);
+		Instances->RegisterComponent();
+	}
+
+	Instances->SetStaticMesh(FlightParams.Mesh);
+	for (int32 MaterialIndex = 0; MaterialIndex < FlightParams.Materials.Num(); ++MaterialIndex)
+	{
+		Instances->SetMaterial(MaterialIndex, FlightParams.Materials[MaterialIndex]);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ProjectileSubsystem: Configured from %s (speed %.0f, mesh %s)"),
+		*RocketClass->GetName(), FlightParams.Speed,
+		FlightParams.Mesh ? *FlightParams.Mesh->GetName() : TEXT("NULL"));
+}
+
+void UProjectileSubsystem::Fire(const FVector& Origin, const FVector& Direction, double FireTime)
+{
+	if (!IsConfigured())
+	{
+		return;
+	}
+
+	FProjectileShot& Shot = Shots.AddDefaulted_GetRef();
+	Shot.Origin = Origin;
+	Shot.Direction = Direction.GetSafeNormal();
+	Shot.Speed = FlightParams.Speed;
+	Shot.SpawnTime = FireTime;
+
+	UFXSystemComponent* Trail = nullptr;
+	if (UTrailPoolSubsystem* TrailPool = GetWorld()->GetSubsystem<UTrailPoolSubsystem>())
+	{
+		Trail = TrailPool->Acquire(FlightParams.TrailEffect, nullptr, Origin);
+	}
+	Trails.Add(Trail);
+
+	if (Instances)
+	{
+		Instances->AddInstance(FTransform::Identity, true);
+	}
+
+	if (UWeaponAudioSubsystem* WeaponAudio = GetWorld()->GetSubsystem<UWeaponAudioSubsystem>())
+	{
+		WeaponAudio->PlayWeaponSound(FlightParams.FireSound, Origin);
+	}
+
+	SET_DWORD_STAT(STAT_ProjectilesActive, Shots.Num());
+}
+
+// ==================== Simulation ====================
+
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileStep);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Last frame's sweeps are always consumed first, also right after switching modes
+	ResolveAsyncSweeps();
+
+	if (CVarProjectileAsyncSweeps.GetValueOnGameThread() != 0)
+	{
+		StepShotsAsync(Now);
+	}
+	else
+	{
+		StepShots(Now);
+	}
+
+	UpdateVisuals();
+	SET_DWORD_STAT(STAT_ProjectilesActive, Shots.Num());
+}
+
+void UProjectileSubsystem::StepShots(double Now)
+{
+	UWorld* World = GetWorld();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSweep), false);
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(FlightParams.CollisionRadius);
+
+	// Backwards so removal can swap the last shot (already stepped) into the freed slot
+	for (int32 Index = Shots.Num() - 1; Index >= 0; --Index)
+	{
+		FProjectileShot& Shot = Shots[Index];
+		const float FlightTime = static_cast<float>(Now - Shot.SpawnTime);
+		const float Target = FMath::Min(FlightTime * Shot.Speed, FlightParams.MaxFlightDistance);
+
+		const FVector From = Shot.Origin + Shot.Direction * Shot.Travelled;
+		const FVector To = Shot.Origin + Shot.Direction * Target;
+
+		if (Target > Shot.Travelled)
+		{
+			APawn* HitEnemy = nullptr;
+			const float EnemyFraction = SweepEnemies(From, To, FlightParams.CollisionRadius, HitEnemy);
+
+			// Terrain and other static geometry in front of the enemy hit (or along the whole segment),
+			// swept with the same sphere as the async path so both agree on every shot
+			FHitResult Hit;
+			if (World->SweepSingleByChannel(Hit, From, FMath::Lerp(From, To, EnemyFraction), FQuat::Identity, ECC_WorldStatic, Sphere, QueryParams))
+			{
+				Detonate(Hit.Location, nullptr);
+				RemoveShot(Index);
+				continue;
+			}
+
+			if (HitEnemy)
+			{
+				Detonate(FMath::Lerp(From, To, EnemyFraction), HitEnemy);
+				RemoveShot(Index);
+				continue;
+			}
+		}
+
+		if (FlightTime >= FlightParams.LifeSpan || Target >= FlightParams.MaxFlightDistance)
+		{
+			RemoveShot(Index);
+			continue;
+		}
+
+		Shot.Travelled = Target;
+		if (UFXSystemComponent* Trail = Trails[Index])
+		{
+			Trail->SetWorldLocation(To);
+		}
+	}
+}
+
+void UProjectileSubsystem::ResolveAsyncSweeps()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileHitResolve);
+
+	UWorld* World = GetWorld();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSweep), false);
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(FlightParams.CollisionRadius);
+
+	for (int32 Index = Shots.Num() - 1; Index >= 0; --Index)
+	{
+		FProjectileShot& Shot = Shots[Index];
+		if (!Shot.PendingTrace.IsValid())
+		{
+			continue;
+		}
+
+		// A blocking hit in front of the recorded enemy hit wins
+		bool bHitTerrain = false;
+		FVector TerrainImpact = FVector::ZeroVector;
+		FTraceDatum Datum;
+		if (World->QueryTraceData(Shot.PendingTrace, Datum))
+		{
+			for (const FHitResult& Hit : Datum.OutHits)
+			{
+				if (Hit.bBlockingHit && Hit.Time <= Shot.PendingEnemyFraction)
+				{
+					bHitTerrain = true;
+					TerrainImpact = Hit.Location;
+					break;
+				}
+			}
+		}
+		else
+		{
+			// The result is gone (expired across a skipped or paused tick, or already swapped out),
+			// so sweep the segment now rather than let the rocket fly through whatever was there
+			const FVector From = Shot.Origin + Shot.Direction * Shot.PendingStart;
+			const FVector To = Shot.Origin + Shot.Direction * Shot.Travelled;
+			FHitResult Hit;
+			bHitTerrain = World->SweepSingleByChannel(Hit, From, FMath::Lerp(From, To, Shot.PendingEnemyFraction), FQuat::Identity, ECC_WorldStatic, Sphere, QueryParams);
+		}
+
+		APawn* HitEnemy = Shot.PendingEnemy.Get();
+		const bool bFinalSegment = Shot.bFinalSegment;
+		Shot.PendingTrace = FTraceHandle();
+		Shot.PendingEnemy.Reset();
+		Shot.PendingEnemyFraction = 1.0f;
+
+		if (bHitTerrain)
+		{
+			Detonate(TerrainImpact, nullptr);
+			RemoveShot(Index);
+		}
+		else if (HitEnemy && !HitEnemy->IsActorBeingDestroyed())
+		{
+			Detonate(Shot.PendingEnemyImpact, HitEnemy);
+			RemoveShot(Index);
+		}
+		else if (bFinalSegment)
+		{
+			RemoveShot(Index);
+		}
+	}
+}
+
+void UProjectileSubsystem::StepShotsAsync(double Now)
+{
+	UWorld* World = GetWorld();
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileAsyncSweep), false);
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(FlightParams.CollisionRadius);
+
+	int32 NumSubmitted = 0;
+	for (int32 Index = Shots.Num() - 1; Index >= 0; --Index)
+	{
+		FProjectileShot& Shot = Shots[Index];
+		const float FlightTime = static_cast<float>(Now - Shot.SpawnTime);
+		const float Target = FMath::Min(FlightTime * Shot.Speed, FlightParams.MaxFlightDistance);
+		const bool bFinalSegment = FlightTime >= FlightParams.LifeSpan || Target >= FlightParams.MaxFlightDistance;
+
+		if (Target <= Shot.Travelled)
+		{
+			if (bFinalSegment)
+			{
+				RemoveShot(Index);
+			}
+			continue;
+		}
+
+		const FVector From = Shot.Origin + Shot.Direction * Shot.Travelled;
+		const FVector To = Shot.Origin + Shot.Direction * Target;
+
+		// Enemies come from the grid right away; only the static-geometry sweep waits a frame
+		APawn* HitEnemy = nullptr;
+		Shot.PendingEnemyFraction = SweepEnemies(From, To, FlightParams.CollisionRadius, HitEnemy);
+		Shot.PendingEnemy = HitEnemy;
+		Shot.PendingEnemyImpact = FMath::Lerp(From, To, Shot.PendingEnemyFraction);
+		Shot.bFinalSegment = bFinalSegment;
+		Shot.PendingStart = Shot.Travelled;
+		Shot.PendingTrace = World->AsyncSweepByChannel(EAsyncTraceType::Single, From, To, FQuat::Identity,
+			ECC_WorldStatic, Sphere, QueryParams);
+		++NumSubmitted;
+
+		Shot.Travelled = Target;
+		if (UFXSystemComponent* Trail = Trails[Index])
+		{
+			Trail->SetWorldLocation(To);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ProjectileSweepsSubmitted, NumSubmitted);
+}
+
+float UProjectileSubsystem::SweepEnemies(const FVector& From, const FVector& To, float Radius, APawn*& OutEnemy, uint8 TypeMask) const
+{
+	UWorld* World = GetWorld();
+	float BestFraction = 1.0f;
+	OutEnemy = nullptr;
+
+	// Grid candidates near the segment, then an exact swept test against their bounds
+	const UEnemySpatialGridSubsystem* SpatialGrid = World->GetSubsystem<UEnemySpatialGridSubsystem>();
+	const UEnemyMovementSubsystem* Movement = World->GetSubsystem<UEnemyMovementSubsystem>();
+	if (!SpatialGrid || !Movement)
+	{
+		return BestFraction;
+	}
+
+	TArray<FEnemyHandle> Candidates;
+	SpatialGrid->QuerySegment(From, To, Radius + MaxEnemyHitRadius, Candidates, nullptr, TypeMask);
+
+	const FVector Extent(Radius);
+	for (const FEnemyHandle& Candidate : Candidates)
+	{
+		APawn* Enemy = Movement->GetActor(Candidate);
+		if (!Enemy || Enemy->IsActorBeingDestroyed())
+		{
+			continue;
+		}
+
+		FVector HitLocation;
+		FVector HitNormal;
+		float HitTime = 1.0f;
+		const FBox Bounds = Enemy->GetComponentsBoundingBox();
+		if (Bounds.IsValid && FMath::LineExtentBoxIntersection(Bounds, From, To, Extent, HitLocation, HitNormal, HitTime)
+			&& HitTime < BestFraction)
+		{
+			BestFraction = HitTime;
+			OutEnemy = Enemy;
+		}
+	}
+
+	return BestFraction;
+}
+
+void UProjectileSubsystem::Detonate(const FVector& Location, APawn* DirectHit) const
+{
+	if (DirectHit)
+	{
+		UE_LOG(LogTemp, Log, TEXT("ProjectileSubsystem: Direct hit on %s!"),
+			DirectHit->IsA<ATankAI>() ? TEXT("tank") : DirectHit->IsA<AHeliAI>() ? TEXT("helicopter") : TEXT("UFO"));
+	}
+
+	if (UAreaDamageSubsystem* AreaDamage = GetWorld()->GetSubsystem<UAreaDamageSubsystem>())
+	{
+		AreaDamage->ApplyRadialDamage(Location, FlightParams.ExplosionRadius, nullptr, DirectHit);
+	}
+}
+
+void UProjectileSubsystem::RemoveShot(int32 Index)
+{
+	// The pool lets the trail fade out, then reuses it
+	if (UFXSystemComponent* Trail = Trails[Index])
+	{
+		if (UTrailPoolSubsystem* TrailPool = GetWorld()->GetSubsystem<UTrailPoolSubsystem>())
+		{
+			TrailPool->Release(Trail);
+		}
+	}
+
+	Shots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Trails.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// Instances are rewritten every frame, so dropping the last one keeps them in step
+	if (Instances && Instances->GetInstanceCount() > 0)
+	{
+		Instances->RemoveInstance(Instances->GetInstanceCount() - 1);
+	}
+}
+
+void UProjectileSubsystem::UpdateVisuals()
+{
+	if (!Instances || Shots.Num() == 0)
+	{
+		return;
+	}
+
+	InstanceTransforms.Reset(Shots.Num());
+	for (const FProjectileShot& Shot : Shots)
+	{
+		const FTransform Flight(UKismetMathLibrary::MakeRotFromX(Shot.Direction), Shot.Origin + Shot.Direction * Shot.Travelled);
+		InstanceTransforms.Add(FlightParams.MeshTransform * Flight);
+	}
+
+	Instances->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+}
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RocketProjectile.h"
+#include "EnemyTypes.h"
+#include "WorldCollision.h"
+#include "ProjectileSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UFXSystemComponent;
+
+/** One rocket in flight; its position is a pure function of time */
+struct FProjectileShot
+{
+	FVector Origin = FVector::ZeroVector;
+	FVector Direction = FVector::ForwardVector;
+	float Speed = 0.0f;
+	double SpawnTime = 0.0;
+
+	/** Distance along the flight line already hit-tested */
+	float Travelled = 0.0f;
+
+	// ==================== Async Sweep (resolved next frame) ====================
+
+	/** Terrain sweep of the last segment, in flight on the physics thread */
+	FTraceHandle PendingTrace;
+
+	/** Distance along the flight line the last segment started at (it ends at Travelled) */
+	float PendingStart = 0.0f;
+
+	/** Enemy struck on the last segment, if any, and where along it */
+	TWeakObjectPtr<APawn> PendingEnemy;
+	float PendingEnemyFraction = 1.0f;
+	FVector PendingEnemyImpact = FVector::ZeroVector;
+
+	/** The last segment ended the flight (lifespan or range); remove once it is resolved */
+	bool bFinalSegment = false;
+};
+
+/**
+ * Actorless rocket simulation. Rockets are plain structs advanced in one batch per frame;
+ * the segment each one covered since the last frame is swept against enemy bounds (candidates
+ * from UEnemySpatialGridSubsystem) and static world geometry, so hits don't depend on frame rate.
+ * Visuals are one instanced mesh for all rocket bodies plus a pooled trail per rocket.
+ * Settings (speed, lifespan, mesh, trail, sound) come from a rocket class's defaults.
+ *
+ * With ZeGunner.Projectile.AsyncSweeps on, the static-geometry sweeps are submitted with
+ * AsyncSweepByChannel and resolved together at the start of the next tick, so the physics
+ * query cost leaves the game thread; hits are applied one frame later in one batch.
+ */
+UCLASS()
+class ZEGUNNER_API UProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Shots.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Take flight and visual settings from a rocket class and create the instanced mesh */
+	void Configure(TSubclassOf<ARocketProjectile> InRocketClass);
+
+	/** Whether Configure has been called with a valid class */
+	bool IsConfigured() const { return RocketClass != nullptr; }
+
+	/**
+	 * Launch a rocket from Origin along Direction.
+	 * @param FireTime - World time the shot left Origin; a shot owed earlier in the frame is swept from Origin up to where it is now
+	 */
+	void Fire(const FVector& Origin, const FVector& Direction, double FireTime);
+
+	/** Rockets currently in flight */
+	int32 GetNumActive() const { return Shots.Num(); }
+
+	/**
+	 * Sweep a sphere of Radius from From to To against enemy bounds (shared with bombs).
+	 * Returns the fraction along the segment of the first enemy hit (1 if none) and that enemy.
+	 */
+	float SweepEnemies(const FVector& From, const FVector& To, float Radius, APawn*& OutEnemy, uint8 TypeMask = AllEnemyTypesMask) const;
+
+private:
+	/** Enemies whose center is farther than this from a flight segment can't be touching it */
+	static constexpr float MaxEnemyHitRadius = 600.0f;
+
+	UPROPERTY(Transient)
+	TSubclassOf<ARocketProjectile> RocketClass;
+
+	FRocketFlightParams FlightParams;
+
+	TArray<FProjectileShot> Shots;
+
+	/** Trail per shot, indexed with Shots (null when the rocket has no trail) */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UFXSystemComponent>> Trails;
+
+	/** Owner of the instanced rocket mesh */
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> VisualsActor;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+	/** Scratch buffer for the per-frame instance update */
+	TArray<FTransform> InstanceTransforms;
+
+	/** Advance every shot and resolve its hits immediately */
+	void StepShots(double Now);
+
+	/** Apply last frame's async sweep results in one batch */
+	void ResolveAsyncSweeps();
+
+	/** Advance every shot, record enemy hits and submit the terrain sweeps for next frame */
+	void StepShotsAsync(double Now);
+
+	/** Queue the rocket's blast (splash plus the enemy it struck, if any) with the area damage pass */
+	void Detonate(const FVector& Location, APawn* DirectHit) const;
+
+	void RemoveShot(int32 Index);
+	void UpdateVisuals();
+};
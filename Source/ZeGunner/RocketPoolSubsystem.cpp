@@ -0,0 +1,152 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RocketPoolSubsystem.h"
+#include "RocketProjectile.h"
+#include "ZeGunner.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rockets Active"), STAT_RocketsActive, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rockets Pooled"), STAT_RocketsPooled, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rocket Pool High Water"), STAT_RocketPoolHighWater, STATGROUP_ZeGunner);
+
+bool URocketPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId URocketPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URocketPoolSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Pool ====================
+
+void URocketPoolSubsystem::Prewarm(TSubclassOf<ARocketProjectile> RocketClass, int32 Count, AActor* Owner)
+{
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (ARocketProjectile* Rocket = SpawnPooledRocket(RocketClass, Owner))
+		{
+			FreeRockets.Add(Rocket);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("RocketPool: Prewarmed %d rockets"), FreeRockets.Num());
+	UpdateStats();
+}
+
+ARocketProjectile* URocketPoolSubsystem::Acquire(TSubclassOf<ARocketProjectile> RocketClass, const FVector& Location, const FVector& Direction, AActor* Owner)
+{
+	if (!RocketClass)
+	{
+		return nullptr;
+	}
+
+	ARocketProjectile* Rocket = nullptr;
+	for (int32 Index = FreeRockets.Num() - 1; Index >= 0; --Index)
+	{
+		ARocketProjectile* Candidate = FreeRockets[Index];
+		if (!IsValid(Candidate))
+		{
+			FreeRockets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+		if (Candidate->GetClass() == RocketClass)
+		{
+			Rocket = Candidate;
+			FreeRockets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			break;
+		}
+	}
+
+	if (!Rocket)
+	{
+		Rocket = SpawnPooledRocket(RocketClass, Owner);
+		if (!Rocket)
+		{
+			return nullptr;
+		}
+		UE_LOG(LogTemp, Log, TEXT("RocketPool: Pool empty, spawned a new rocket (%d in flight)"), ActiveRockets.Num() + 1);
+	}
+
+	Rocket->SetOwner(Owner);
+	Rocket->Launch(Location, Direction);
+
+	ActiveRockets.Add(Rocket);
+	HighWaterMark = FMath::Max(HighWaterMark, ActiveRockets.Num());
+	UpdateStats();
+
+	return Rocket;
+}
+
+void URocketPoolSubsystem::Release(ARocketProjectile* Rocket)
+{
+	if (!Rocket || ActiveRockets.RemoveSingleSwap(Rocket, EAllowShrinking::No) == 0)
+	{
+		return;
+	}
+
+	Rocket->ReturnToPool();
+	FreeRockets.Add(Rocket);
+	UpdateStats();
+}
+
+ARocketProjectile* URocketPoolSubsystem::SpawnPooledRocket(TSubclassOf<ARocketProjectile> RocketClass, AActor* Owner)
+{
+	UWorld* World = GetWorld();
+	if (!World || !RocketClass)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.Owner = Owner;
+	SpawnParams.bDeferConstruction = true;
+
+	ARocketProjectile* Rocket = World->SpawnActor<ARocketProjectile>(RocketClass, FTransform::Identity, SpawnParams);
+	if (!Rocket)
+	{
+		return nullptr;
+	}
+
+	// Pooled rockets are retired by the pool, not by an actor lifespan
+	Rocket->SetOwningPool(this);
+	Rocket->FinishSpawning(FTransform::Identity);
+	Rocket->ReturnToPool();
+	return Rocket;
+}
+
+// ==================== Tick ====================
+
+void URocketPoolSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Lifespan and battlefield bounds; a hit releases the rocket on its own
+	for (int32 Index = ActiveRockets.Num() - 1; Index >= 0; --Index)
+	{
+		ARocketProjectile* Rocket = ActiveRockets[Index];
+		if (!IsValid(Rocket))
+		{
+			ActiveRockets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (Rocket->IsFlightOver(Now))
+		{
+			Release(Rocket);
+		}
+	}
+
+	UpdateStats();
+}
+
+void URocketPoolSubsystem::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_RocketsActive, ActiveRockets.Num());
+	SET_DWORD_STAT(STAT_RocketsPooled, FreeRockets.Num());
+	SET_DWORD_STAT(STAT_RocketPoolHighWater, HighWaterMark);
+}
@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RocketPoolSubsystem.generated.h"
+
+class ARocketProjectile;
+
+/**
+ * Recycles rocket actors instead of spawning and destroying one per shot.
+ * Idle rockets stay hidden with collision, movement and trails off. Acquire teleports one
+ * into place and relaunches it; hits, the lifespan and leaving the battlefield hand it back.
+ * The pool grows on demand, so the high-water mark is the size to prewarm to.
+ */
+UCLASS()
+class ZEGUNNER_API URocketPoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return ActiveRockets.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Spawn idle rockets up front so the first volleys don't hitch */
+	void Prewarm(TSubclassOf<ARocketProjectile> RocketClass, int32 Count, AActor* Owner);
+
+	/** Launch a rocket from the pool (spawning one if none of this class is idle) */
+	ARocketProjectile* Acquire(TSubclassOf<ARocketProjectile> RocketClass, const FVector& Location, const FVector& Direction, AActor* Owner);
+
+	/** Hand a rocket back; it is hidden and parked until the next Acquire */
+	void Release(ARocketProjectile* Rocket);
+
+	/** Rockets currently in flight */
+	int32 GetNumActive() const { return ActiveRockets.Num(); }
+
+	/** Idle rockets waiting to be launched */
+	int32 GetNumPooled() const { return FreeRockets.Num(); }
+
+	/** Most rockets in flight at once since the level started */
+	int32 GetHighWaterMark() const { return HighWaterMark; }
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ARocketProjectile>> FreeRockets;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ARocketProjectile>> ActiveRockets;
+
+	int32 HighWaterMark = 0;
+
+	ARocketProjectile* SpawnPooledRocket(TSubclassOf<ARocketProjectile> RocketClass, AActor* Owner);
+
+	void UpdateStats() const;
+};
@@ -1,17 +1,14 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "RocketProjectile.h"
-#include "TankAI.h"
-#include "HeliAI.h"
-#include "UFOAI.h"
-#include "FighterPawn.h"
+#include "RocketPoolSubsystem.h"
+#include "AreaDamageSubsystem.h"
+#include "TrailPoolSubsystem.h"
+#include "WeaponAudioSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Particles/ParticleSystem.h"
-#include "Particles/ParticleSystemComponent.h"
-#include "NiagaraFunctionLibrary.h"
-#include "NiagaraComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "NiagaraSystem.h"
 #include "Kismet/KismetMathLibrary.h"
 
 ARocketProjectile::ARocketProjectile()
@@ -21,7 +18,8 @@ ARocketProjectile::ARocketProjectile()
 	// Create collision sphere as root
 	CollisionComponent = CreateDefaultSubobject<USphereComponent>(TEXT("CollisionComponent"));
 	CollisionComponent->InitSphereRadius(20.0f);
-	CollisionComponent->SetCollisionProfileName(TEXT("BlockAllDynamic"));
+	CollisionComponent->SetCollisionProfileName(TEXT("Projectile"));
+	CollisionComponent->SetGenerateOverlapEvents(false);
 	CollisionComponent->SetSimulatePhysics(false);
 	CollisionComponent->SetEnableGravity(false);
 	CollisionComponent->SetNotifyRigidBodyCollision(true);
@@ -32,10 +30,6 @@ ARocketProjectile::ARocketProjectile()
 	RocketMesh->SetupAttachment(RootComponent);
 	RocketMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-	// Create particle system component for trail
-	TrailComponent = CreateDefaultSubobject<UParticleSystemComponent>(TEXT("TrailComponent"));
-	TrailComponent->SetupAttachment(RootComponent);
-
 	// Projectile movement - handles flight with no gravity
 	ProjectileMovement = CreateDefaultSubobject<UProjectileMovementComponent>(TEXT("ProjectileMovement"));
 	ProjectileMovement->UpdatedComponent = CollisionComponent;
@@ -63,8 +57,6 @@ void ARocketProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 
-	SetLifeSpan(LifeSpan);
-
 	// Ensure physics is off - ProjectileMovement handles everything
 	CollisionComponent->SetSimulatePhysics(false);
 	CollisionComponent->SetEnableGravity(false);
@@ -81,46 +73,139 @@ void ARocketProjectile::BeginPlay()
 		RocketMesh->SetRelativeRotation(MeshRotationOffset);
 	}
 
-	// Set up trail - try Niagara first, then Cascade
+	if (!TrailNiagaraEffect && !TrailEffect)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RocketProjectile: No trail effect assigned"));
+	}
+
+	// Pooled rockets wait for Launch; a directly spawned rocket flies right away
+	if (!OwningPool.IsValid())
+	{
+		SetLifeSpan(LifeSpan);
+		LaunchTime = GetWorld()->GetTimeSeconds();
+		LaunchLocation = GetActorLocation();
+		StartFlightEffects();
+
+		UE_LOG(LogTemp, Warning, TEXT("RocketProjectile: BeginPlay - Velocity=%s Speed=%.0f"),
+			*ProjectileMovement->Velocity.ToString(), RocketSpeed);
+	}
+}
+
+void ARocketProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The trail belongs to the pool; let it fade instead of dying with the rocket
+	ReleaseTrail();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARocketProjectile::StartFlightEffects()
+{
+	ReleaseTrail();
+	if (UTrailPoolSubsystem* TrailPool = GetWorld()->GetSubsystem<UTrailPoolSubsystem>())
+	{
+		ActiveTrail = TrailPool->Acquire(GetTrailAsset(), RootComponent, GetActorLocation());
+	}
+
+	// Play fire sound when rocket launches
+	if (UWeaponAudioSubsystem* WeaponAudio = GetWorld()->GetSubsystem<UWeaponAudioSubsystem>())
+	{
+		WeaponAudio->PlayWeaponSound(FireSound, GetActorLocation());
+	}
+}
+
+UFXSystemAsset* ARocketProjectile::GetTrailAsset() const
+{
+	// Niagara first, then Cascade
 	if (TrailNiagaraEffect)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("RocketProjectile: TrailNiagaraEffect assigned: %s"), *TrailNiagaraEffect->GetName());
-		UNiagaraFunctionLibrary::SpawnSystemAttached(TrailNiagaraEffect, RootComponent, NAME_None, FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::KeepRelativeOffset, true);
-		UE_LOG(LogTemp, Warning, TEXT("RocketProjectile: Niagara trail activated"));
+		return TrailNiagaraEffect;
 	}
-	else if (TrailEffect)
+	return TrailEffect;
+}
+
+FRocketFlightParams ARocketProjectile::GetFlightParams() const
+{
+	FRocketFlightParams Params;
+	Params.Speed = RocketSpeed;
+	Params.LifeSpan = LifeSpan;
+	Params.MaxFlightDistance = MaxFlightDistance;
+	Params.CollisionRadius = CollisionComponent ? CollisionComponent->GetUnscaledSphereRadius() : Params.CollisionRadius;
+	Params.ExplosionRadius = ExplosionRadius;
+	Params.TrailEffect = GetTrailAsset();
+	Params.FireSound = FireSound;
+
+	if (RocketMesh)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("RocketProjectile: TrailEffect assigned: %s"), *TrailEffect->GetName());
-		if (TrailComponent)
-		{
-			TrailComponent->SetTemplate(TrailEffect);
-			TrailComponent->ActivateSystem();
-			UE_LOG(LogTemp, Warning, TEXT("RocketProjectile: Cascade trail activated"));
-		}
+		Params.Mesh = RocketMesh->GetStaticMesh();
+		Params.Materials = RocketMesh->GetMaterials();
+		Params.MeshTransform = FTransform(MeshRotationOffset, RocketMesh->GetRelativeLocation(), RocketMesh->GetRelativeScale3D());
 	}
-	else
+
+	return Params;
+}
+
+// ==================== Pooling ====================
+
+void ARocketProjectile::Launch(const FVector& Location, const FVector& Direction)
+{
+	const FVector Dir = Direction.GetSafeNormal().IsNearlyZero() ? GetActorForwardVector() : Direction.GetSafeNormal();
+
+	// Move before the trail restarts so it doesn't streak from the parking spot
+	SetActorLocationAndRotation(Location, UKismetMathLibrary::MakeRotFromX(Dir), false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	ProjectileMovement->SetUpdatedComponent(CollisionComponent);
+	ProjectileMovement->Activate(true);
+	ProjectileMovement->Velocity = Dir * RocketSpeed;
+
+	LaunchTime = GetWorld()->GetTimeSeconds();
+	LaunchLocation = Location;
+	StartFlightEffects();
+}
+
+void ARocketProjectile::ReturnToPool()
+{
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	ReleaseTrail();
+}
+
+void ARocketProjectile::ReleaseTrail()
+{
+	if (!ActiveTrail)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("RocketProjectile: No trail effect assigned"));
+		return;
 	}
 
-	// Play fire sound when rocket spawns
-	if (FireSound)
+	if (UTrailPoolSubsystem* TrailPool = GetWorld()->GetSubsystem<UTrailPoolSubsystem>())
 	{
-		float Volume = 1.0f;
-		if (AFighterPawn* Fighter = Cast<AFighterPawn>(GetOwner()))
-		{
-			Volume = Fighter->GetSoundVolume();
-		}
-		UGameplayStatics::PlaySoundAtLocation(this, FireSound, GetActorLocation(), Volume);
+		TrailPool->Release(ActiveTrail);
 	}
+	ActiveTrail = nullptr;
+}
 
-	UE_LOG(LogTemp, Warning, TEXT("RocketProjectile: BeginPlay - Velocity=%s Speed=%.0f"),
-		*ProjectileMovement->Velocity.ToString(), RocketSpeed);
+bool ARocketProjectile::IsFlightOver(double Now) const
+{
+	return Now - LaunchTime >= LifeSpan
+		|| FVector::DistSquared(GetActorLocation(), LaunchLocation) > FMath::Square(MaxFlightDistance);
 }
 
-void ARocketProjectile::Tick(float DeltaTime)
+void ARocketProjectile::FinishFlight()
 {
-	Super::Tick(DeltaTime);
+	if (URocketPoolSubsystem* Pool = OwningPool.Get())
+	{
+		Pool->Release(this);
+	}
+	else
+	{
+		Destroy();
+	}
 }
 
 void ARocketProjectile::OnRocketHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
@@ -133,24 +218,13 @@ void ARocketProjectile::OnRocketHit(UPrimitiveComponent* HitComp, AActor* OtherA
 
 	UE_LOG(LogTemp, Log, TEXT("RocketProjectile: Hit %s"), *OtherActor->GetName());
 
-	// Check if we directly hit a helicopter or tank
-	if (AHeliAI* Heli = Cast<AHeliAI>(OtherActor))
-	{
-		UE_LOG(LogTemp, Log, TEXT("RocketProjectile: Direct hit on helicopter!"));
-		Heli->Destroy();
-	}
-	else if (ATankAI* Tank = Cast<ATankAI>(OtherActor))
-	{
-		UE_LOG(LogTemp, Log, TEXT("RocketProjectile: Direct hit on tank!"));
-		Tank->Destroy();
-	}
-	else if (AUFOAI* UFO = Cast<AUFOAI>(OtherActor))
+	// Splash plus the actor we struck, resolved with every other blast this frame
+	if (UAreaDamageSubsystem* AreaDamage = GetWorld()->GetSubsystem<UAreaDamageSubsystem>())
 	{
-		UE_LOG(LogTemp, Log, TEXT("RocketProjectile: Direct hit on UFO!"));
-		UFO->Destroy();
+		AreaDamage->ApplyRadialDamage(Hit.bBlockingHit ? FVector(Hit.ImpactPoint) : GetActorLocation(), ExplosionRadius, GetOwner(), OtherActor);
 	}
 
-	// Destroy the rocket
-	Destroy();
+	// Recycle (or destroy) the rocket
+	FinishFlight();
 }
 
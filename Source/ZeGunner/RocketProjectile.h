@@ -11,6 +11,37 @@
 #include "Sound/SoundBase.h"
 #include "RocketProjectile.generated.h"
 
+class URocketPoolSubsystem;
+class UNiagaraSystem;
+class UFXSystemAsset;
+class UFXSystemComponent;
+class UStaticMesh;
+class UMaterialInterface;
+
+/** What the actorless projectile simulation needs from a rocket class, read off its defaults */
+struct FRocketFlightParams
+{
+	float Speed = 8000.0f;
+	float LifeSpan = 10.0f;
+	float MaxFlightDistance = 60000.0f;
+
+	/** Radius of the rocket's collision sphere */
+	float CollisionRadius = 20.0f;
+
+	/** Splash radius (0 = direct hit only) */
+	float ExplosionRadius = 200.0f;
+
+	UStaticMesh* Mesh = nullptr;
+	TArray<UMaterialInterface*> Materials;
+
+	/** Mesh transform relative to the rocket (rotation offset and scale) */
+	FTransform MeshTransform = FTransform::Identity;
+
+	/** Niagara or Cascade trail, whichever the rocket uses */
+	UFXSystemAsset* TrailEffect = nullptr;
+	USoundBase* FireSound = nullptr;
+};
+
 UCLASS()
 class ZEGUNNER_API ARocketProjectile : public AActor
 {
@@ -22,13 +53,36 @@ public:
 	/** Set the rocket's flight direction (called by BomberPawn on spawn) */
 	void SetFlightDirection(const FVector& Direction);
 
+	/** Flight speed (units/sec) */
+	float GetRocketSpeed() const { return RocketSpeed; }
+
+	/** Flight and visual settings, meant to be read from the class default object */
+	FRocketFlightParams GetFlightParams() const;
+
+	/** Trail effect to draw from the trail pool (Niagara if set, else Cascade) */
+	UFXSystemAsset* GetTrailAsset() const;
+
+	// ==================== Pooling ====================
+
+	/** Mark this rocket as owned by a pool (before BeginPlay); it is then recycled instead of destroyed */
+	void SetOwningPool(URocketPoolSubsystem* Pool) { OwningPool = Pool; }
+
+	/** Teleport to Location and fly along Direction with a fresh trail and lifespan */
+	void Launch(const FVector& Location, const FVector& Direction);
+
+	/** Hide and stop the rocket so it can be parked in the pool */
+	void ReturnToPool();
+
+	/** Whether the lifespan ran out or the rocket left the battlefield */
+	bool IsFlightOver(double Now) const;
+
 	/** Projectile movement component handles flight */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rocket")
 	UProjectileMovementComponent* ProjectileMovement;
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** Collision sphere for hit detection */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rocket")
@@ -38,10 +92,6 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rocket")
 	class UStaticMeshComponent* RocketMesh;
 
-	/** Particle system component for rocket trail */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rocket")
-	class UParticleSystemComponent* TrailComponent;
-
 	/** Particle system for the rocket trail effect (Cascade) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket")
 	class UParticleSystem* TrailEffect;
@@ -58,6 +108,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket", meta = (ClampMin = "1.0"))
 	float LifeSpan = 10.0f;
 
+	/** Pooled rockets are recycled once this far from where they were launched (units) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket", meta = (ClampMin = "1000.0"))
+	float MaxFlightDistance = 60000.0f;
+
 	/** Explosion radius for splash damage (0 = direct hit only) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rocket", meta = (ClampMin = "0.0"))
 	float ExplosionRadius = 200.0f;
@@ -76,4 +130,21 @@ private:
 	UFUNCTION()
 	void OnRocketHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/** Take a trail from the trail pool and play the fire sound */
+	void StartFlightEffects();
+
+	/** Hand the trail back to the pool to fade out where the rocket stopped */
+	void ReleaseTrail();
+
+	/** Back to the pool, or destroyed when not pooled */
+	void FinishFlight();
+
+	TWeakObjectPtr<URocketPoolSubsystem> OwningPool;
+
+	/** Trail borrowed from UTrailPoolSubsystem for the current flight */
+	UPROPERTY(Transient)
+	TObjectPtr<UFXSystemComponent> ActiveTrail;
+
+	double LaunchTime = 0.0;
+	FVector LaunchLocation = FVector::ZeroVector;
 };
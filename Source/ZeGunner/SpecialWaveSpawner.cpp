@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SpecialWaveSpawner.h"
+#include "EnemyKillSubsystem.h"
 #include "UFOAI.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
@@ -17,6 +18,22 @@ void ASpecialWaveSpawner::BeginPlay()
 	Super::BeginPlay();
 
 	UE_LOG(LogTemp, Log, TEXT("SpecialWaveSpawner: Initialized. Special enemies start after wave %d."), StartAfterWave);
+
+	// Kills arrive in one batch per frame; our enemies are the ones we own
+	if (UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>())
+	{
+		Kills->OnEnemiesKilled.AddUObject(this, &ASpecialWaveSpawner::OnEnemiesKilled);
+	}
+}
+
+void ASpecialWaveSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>())
+	{
+		Kills->OnEnemiesKilled.RemoveAll(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ASpecialWaveSpawner::TriggerNextWave(int32 WaveNumber)
@@ -81,6 +98,7 @@ void ASpecialWaveSpawner::SpawnUFOs(int32 WaveNumber)
 
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		SpawnParams.Owner = this;
 
 		APawn* SpawnedUFO = GetWorld()->SpawnActor<APawn>(UFOClass, SpawnLocation, SpawnRotation, SpawnParams);
 
@@ -96,7 +114,6 @@ void ASpecialWaveSpawner::SpawnUFOs(int32 WaveNumber)
 				UFO->SetTargetLocation(TargetLocation);
 			}
 
-			SpawnedUFO->OnDestroyed.AddDynamic(this, &ASpecialWaveSpawner::OnEnemyDestroyed);
 			ActiveEnemyCount++;
 
 			UE_LOG(LogTemp, Log, TEXT("SpecialWaveSpawner: Spawned UFO %d/%d at %s"),
@@ -105,8 +122,18 @@ void ASpecialWaveSpawner::SpawnUFOs(int32 WaveNumber)
 	}
 }
 
-void ASpecialWaveSpawner::OnEnemyDestroyed(AActor* DestroyedActor)
+void ASpecialWaveSpawner::OnEnemiesKilled(const FEnemyKillBatch& Batch)
 {
-	ActiveEnemyCount--;
-	UE_LOG(LogTemp, Log, TEXT("SpecialWaveSpawner: Special enemy destroyed. Active remaining: %d"), ActiveEnemyCount);
+	int32 NumKilled = 0;
+	for (const APawn* Victim : Batch.Victims)
+	{
+		NumKilled += Victim->GetOwner() == this ? 1 : 0;
+	}
+	if (NumKilled == 0)
+	{
+		return;
+	}
+
+	ActiveEnemyCount -= NumKilled;
+	UE_LOG(LogTemp, Log, TEXT("SpecialWaveSpawner: Special enemies destroyed: %d. Active remaining: %d"), NumKilled, ActiveEnemyCount);
 }
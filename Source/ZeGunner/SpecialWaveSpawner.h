@@ -7,6 +7,8 @@
 #include "UFOAI.h"
 #include "SpecialWaveSpawner.generated.h"
 
+struct FEnemyKillBatch;
+
 UCLASS()
 class ZEGUNNER_API ASpecialWaveSpawner : public AActor
 {
@@ -27,8 +29,12 @@ public:
 	/** Returns how many UFOs will spawn in the given wave */
 	int32 GetNextWaveUFOCount(int32 WaveNumber) const;
 
+	/** Class this spawner spawns UFOs of */
+	TSubclassOf<class AUFOAI> GetUFOClass() const { return UFOClass; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// ==================== UFO Settings ====================
 
@@ -111,7 +117,6 @@ private:
 	/** Spawn UFOs for the wave */
 	void SpawnUFOs(int32 WaveNumber);
 
-	/** Called when a special enemy is destroyed */
-	UFUNCTION()
-	void OnEnemyDestroyed(AActor* DestroyedActor);
+	/** Bound to the kill subsystem; drops this spawner's victims from the active count */
+	void OnEnemiesKilled(const FEnemyKillBatch& Batch);
 };
@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 #include "ExplosionComponent.h"
-#include "FighterPawn.h"
+#include "EnemyTypes.h"
 #include "TankAI.generated.h"
 
+class UEnemyMovementSubsystem;
+
 UCLASS()
 class ZEGUNNER_API ATankAI : public APawn
 {
@@ -22,7 +24,6 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** The skeletal mesh component for the tank */
@@ -101,71 +102,21 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Tank Movement")
 	float GetMoveSpeed() const { return MoveSpeed; }
 
+	/** Predicted location after the given number of seconds along the precomputed route */
+	UFUNCTION(BlueprintPure, Category = "Tank Movement")
+	FVector PredictLocation(float Seconds) const;
+
 	/** Check if tank has reached the target */
 	UFUNCTION(BlueprintPure, Category = "Tank Movement")
 	bool HasReachedTarget() const;
 
 private:
-	/** Initial spawn position for calculating center angle */
-	FVector InitialSpawnLocation;
-
-	/** Center angle (direct line from spawn to base) in radians */
-	float CenterAngleRad = 0.0f;
-
-	/** Current zigzag direction: 1 = left (positive angle), -1 = right (negative angle) */
-	int32 ZigzagDirection = 1;
-
-	/** Current movement angle in radians (center angle +/- 45 degrees) */
-	float CurrentMovementAngleRad = 0.0f;
-
-	/** Distance remaining to travel on current zigzag leg */
-	float RemainingZigzagDistance = 0.0f;
-
-	/** Has the center line been crossed on current leg? */
-	bool bHasCrossedCenter = false;
-
-	/** Has zigzag movement been initialized? */
-	bool bZigzagInitialized = false;
-
-	/** Has a target been explicitly set? */
-	bool bTargetSet = false;
-
-	/** Whether this tank has reached the line of fire and is shooting */
-	bool bIsFiring = false;
-
 	/** Seconds between shots at the base */
 	float RateOfFire = 3.0f;
 
-	/** Timer counting down to next shot */
-	float FireTimer = 0.0f;
-
-	/** Move the tank toward target */
-	void MoveTowardTarget(float DeltaTime);
-
-	/** Move tank in zigzag pattern */
-	void MoveZigzag(float DeltaTime);
-
-	/** Smoothly rotate toward target */
-	void RotateTowardTarget(float DeltaTime);
-
-	/** Initialize zigzag movement parameters */
-	void InitializeZigzagMovement();
-
-	/** Update zigzag movement direction and calculate new leg */
-	void UpdateZigzagDirection();
-
-	/** Calculate the center angle from spawn to target */
-	float CalculateCenterAngle() const;
-
-	/** Check if tank has crossed the center line */
-	bool HasCrossedCenterLine() const;
-
-	/** Rotate toward the current zigzag movement angle */
-	void RotateTowardZigzagAngle(float DeltaTime);
-
-	/** Fire at the base (damage it) */
-	void FireAtBase();
+	/** Slot in the enemy movement subsystem (movement state lives there) */
+	FEnemyHandle MovementHandle;
 
-	/** Check if the game is currently paused */
-	bool IsGamePaused() const;
+	/** Get the movement subsystem for this world */
+	UEnemyMovementSubsystem* GetMovementSubsystem() const;
 };
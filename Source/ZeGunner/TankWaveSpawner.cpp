@@ -1,7 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TankWaveSpawner.h"
+#include "EnemyKillSubsystem.h"
 #include "TankAI.h"
+#include "EnemyFlowFieldSubsystem.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
@@ -18,6 +20,22 @@ void ATankWaveSpawner::BeginPlay()
 	Super::BeginPlay();
 	
 	UE_LOG(LogTemp, Log, TEXT("TankWaveSpawner: Base target is world origin (0,0,0). Waiting for command to spawn."));
+
+	// Kills arrive in one batch per frame; our enemies are the ones we own
+	if (UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>())
+	{
+		Kills->OnEnemiesKilled.AddUObject(this, &ATankWaveSpawner::OnEnemiesKilled);
+	}
+
+	// Bake the shared steering field once for the whole level (covers the largest spawn ring)
+	if (bUseFlowField)
+	{
+		if (UEnemyFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<UEnemyFlowFieldSubsystem>())
+		{
+			const float Extent = FMath::Max(InitialSpawnRadius, MaxSpawnRadius) + FlowFieldCellSize;
+			FlowField->Bake(FVector::ZeroVector, Extent, LineOfFireDistance, FlowFieldCellSize, bFlowFieldAvoidObstacles);
+		}
+	}
 }
 
 void ATankWaveSpawner::TriggerNextWave()
@@ -27,6 +45,16 @@ void ATankWaveSpawner::TriggerNextWave()
 	SpawnWave();
 }
 
+void ATankWaveSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyKillSubsystem* Kills = GetWorld()->GetSubsystem<UEnemyKillSubsystem>())
+	{
+		Kills->OnEnemiesKilled.RemoveAll(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ATankWaveSpawner::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -77,6 +105,7 @@ void ATankWaveSpawner::SpawnWave()
 		
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		SpawnParams.Owner = this;
 		
 		APawn* SpawnedTank = GetWorld()->SpawnActor<APawn>(TankClass, SpawnLocation, SpawnRotation, SpawnParams);
 		
@@ -98,9 +127,6 @@ void ATankWaveSpawner::SpawnWave()
 				TankAI->SetTargetLocation(TargetLocation);
 			}
 			
-			// Bind to destruction event
-			SpawnedTank->OnDestroyed.AddDynamic(this, &ATankWaveSpawner::OnTankDestroyed);
-			
 			ActiveTankCount++;
 			
 			UE_LOG(LogTemp, Log, TEXT("TankWaveSpawner: Spawned tank %d/%d at %s with speed %.1f"), 
@@ -157,11 +183,21 @@ FVector ATankWaveSpawner::GetRandomSpawnPosition(float Radius)
 	return FVector::ZeroVector;
 }
 
-void ATankWaveSpawner::OnTankDestroyed(AActor* DestroyedActor)
+void ATankWaveSpawner::OnEnemiesKilled(const FEnemyKillBatch& Batch)
 {
-	ActiveTankCount--;
-	UE_LOG(LogTemp, Log, TEXT("TankWaveSpawner: Tank destroyed. Active tanks remaining: %d"), ActiveTankCount);
-	
+	int32 NumKilled = 0;
+	for (const APawn* Victim : Batch.Victims)
+	{
+		NumKilled += Victim->GetOwner() == this ? 1 : 0;
+	}
+	if (NumKilled == 0)
+	{
+		return;
+	}
+
+	ActiveTankCount -= NumKilled;
+	UE_LOG(LogTemp, Log, TEXT("TankWaveSpawner: Tanks destroyed: %d. Active remaining: %d"), NumKilled, ActiveTankCount);
+
 	CheckWaveComplete();
 }
 
@@ -6,6 +6,8 @@
 #include "GameFramework/Actor.h"
 #include "TankWaveSpawner.generated.h"
 
+struct FEnemyKillBatch;
+
 UCLASS()
 class ZEGUNNER_API ATankWaveSpawner : public AActor
 {
@@ -26,8 +28,12 @@ public:
 	/** Returns how many tanks will spawn in the next wave */
 	int32 GetNextWaveTankCount() const { return TanksPerWave + CurrentWave * TanksAddedPerWave; }
 
+	/** Class this spawner spawns tanks of */
+	TSubclassOf<APawn> GetTankClass() const { return TankClass; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
 	/** The skeletal mesh class to spawn for tanks */
@@ -124,6 +130,18 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Spawning", meta = (ClampMin = "0.0"))
 	float ZigzagMaxDistance = 500.0f;
 
+	/** Bake a shared flow field around the base at level start so tanks steer around obstacles */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Flow Field")
+	bool bUseFlowField = true;
+
+	/** Flow field cell size (units) - smaller follows obstacles more closely but takes longer to bake */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Flow Field", meta = (ClampMin = "50.0", EditCondition = "bUseFlowField"))
+	float FlowFieldCellSize = 200.0f;
+
+	/** Trace each flow field cell and route tanks around anything that isn't landscape */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tank Flow Field", meta = (EditCondition = "bUseFlowField"))
+	bool bFlowFieldAvoidObstacles = true;
+
 private:
 	/** Current wave number */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Tank Spawning", meta = (AllowPrivateAccess = "true"))
@@ -146,9 +164,8 @@ private:
 	/** Calculate a random spawn position on the circle that doesn't overlap with others */
 	FVector GetRandomSpawnPosition(float Radius);
 
-	/** Called when a tank is destroyed */
-	UFUNCTION()
-	void OnTankDestroyed(AActor* DestroyedActor);
+	/** Bound to the kill subsystem; drops this spawner's victims from the active count */
+	void OnEnemiesKilled(const FEnemyKillBatch& Batch);
 
 	/** Start the next wave timer */
 	void ScheduleNextWave();
@@ -0,0 +1,207 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TrailPoolSubsystem.h"
+#include "ZeGunner.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Trails Active"), STAT_TrailsActive, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Trails Fading"), STAT_TrailsFading, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Trails Pooled"), STAT_TrailsPooled, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Trail Systems Created"), STAT_TrailSystemsCreated, STATGROUP_ZeGunner);
+
+bool UTrailPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTrailPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrailPoolSubsystem, STATGROUP_Tickables);
+}
+
+// ==================== Pool ====================
+
+void UTrailPoolSubsystem::Prewarm(UFXSystemAsset* Effect, int32 Count)
+{
+	if (!Effect)
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (UFXSystemComponent* Trail = CreateTrail(Effect))
+		{
+			FreeTrails.Add(Trail);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("TrailPool: Prewarmed %d %s trails"), Count, *Effect->GetName());
+	UpdateStats();
+}
+
+UFXSystemComponent* UTrailPoolSubsystem::Acquire(UFXSystemAsset* Effect, USceneComponent* AttachTo, const FVector& Location)
+{
+	if (!Effect)
+	{
+		return nullptr;
+	}
+
+	UFXSystemComponent* Trail = nullptr;
+	for (int32 Index = FreeTrails.Num() - 1; Index >= 0; --Index)
+	{
+		UFXSystemComponent* Candidate = FreeTrails[Index];
+		if (!IsValid(Candidate))
+		{
+			FreeTrails.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+		if (Candidate->GetFXSystemAsset() == Effect)
+		{
+			Trail = Candidate;
+			FreeTrails.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			break;
+		}
+	}
+
+	if (!Trail)
+	{
+		Trail = CreateTrail(Effect);
+		if (!Trail)
+		{
+			return nullptr;
+		}
+		UE_LOG(LogTemp, Log, TEXT("TrailPool: Pool empty, created a new trail (%d active)"), ActiveTrails.Num() + 1);
+	}
+
+	// Place before restarting so the trail doesn't streak from where it last faded
+	if (AttachTo)
+	{
+		Trail->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	}
+	else
+	{
+		Trail->SetWorldLocation(Location);
+	}
+	Trail->Activate(true);
+
+	ActiveTrails.Add(Trail);
+	UpdateStats();
+	return Trail;
+}
+
+void UTrailPoolSubsystem::Release(UFXSystemComponent* Trail)
+{
+	if (!Trail || ActiveTrails.RemoveSingleSwap(Trail, EAllowShrinking::No) == 0)
+	{
+		return;
+	}
+
+	// Stop emitting but keep the particles already in the air
+	Trail->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	Trail->Deactivate();
+
+	FadingTrails.Add(Trail);
+	FadeStartTimes.Add(GetWorld()->GetTimeSeconds());
+	UpdateStats();
+}
+
+UFXSystemComponent* UTrailPoolSubsystem::CreateTrail(UFXSystemAsset* Effect)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	if (!PoolActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		PoolActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!PoolActor)
+		{
+			return nullptr;
+		}
+	}
+
+	UFXSystemComponent* Trail = nullptr;
+	if (UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(Effect))
+	{
+		UNiagaraComponent* NiagaraTrail = NewObject<UNiagaraComponent>(PoolActor);
+		NiagaraTrail->SetAutoDestroy(false);
+		NiagaraTrail->SetAsset(NiagaraSystem);
+		Trail = NiagaraTrail;
+	}
+	else if (UParticleSystem* CascadeSystem = Cast<UParticleSystem>(Effect))
+	{
+		UParticleSystemComponent* CascadeTrail = NewObject<UParticleSystemComponent>(PoolActor);
+		CascadeTrail->bAutoDestroy = false;
+		CascadeTrail->SetTemplate(CascadeSystem);
+		Trail = CascadeTrail;
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	Trail->SetAutoActivate(false);
+	Trail->RegisterComponent();
+	++NumCreated;
+	return Trail;
+}
+
+bool UTrailPoolSubsystem::HasFinished(UFXSystemComponent* Trail)
+{
+	if (const UNiagaraComponent* NiagaraTrail = Cast<UNiagaraComponent>(Trail))
+	{
+		return NiagaraTrail->IsComplete();
+	}
+	if (UParticleSystemComponent* CascadeTrail = Cast<UParticleSystemComponent>(Trail))
+	{
+		return CascadeTrail->HasCompleted();
+	}
+	return true;
+}
+
+// ==================== Tick ====================
+
+void UTrailPoolSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Trails whose last particles have died go back to the idle list
+	for (int32 Index = FadingTrails.Num() - 1; Index >= 0; --Index)
+	{
+		UFXSystemComponent* Trail = FadingTrails[Index];
+		const bool bValid = IsValid(Trail);
+		if (bValid && !HasFinished(Trail) && Now - FadeStartTimes[Index] < MaxFadeSeconds)
+		{
+			continue;
+		}
+
+		FadingTrails.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		FadeStartTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		if (bValid)
+		{
+			Trail->DeactivateImmediate();
+			FreeTrails.Add(Trail);
+		}
+	}
+
+	UpdateStats();
+}
+
+void UTrailPoolSubsystem::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_TrailsActive, ActiveTrails.Num());
+	SET_DWORD_STAT(STAT_TrailsFading, FadingTrails.Num());
+	SET_DWORD_STAT(STAT_TrailsPooled, FreeTrails.Num());
+	SET_DWORD_STAT(STAT_TrailSystemsCreated, NumCreated);
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrailPoolSubsystem.generated.h"
+
+class UFXSystemAsset;
+class UFXSystemComponent;
+
+/**
+ * Recycles rocket trail components (Niagara or Cascade) instead of creating a system instance
+ * per shot. Acquire attaches an idle trail to the rocket and restarts it; Release detaches it
+ * where it is and lets it fade out, after which it goes back to the idle list.
+ * Trail Systems Created should stop growing once the pool covers sustained fire.
+ */
+UCLASS()
+class ZEGUNNER_API UTrailPoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return FadingTrails.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Create idle trails for an effect up front so the first volleys don't allocate */
+	void Prewarm(UFXSystemAsset* Effect, int32 Count);
+
+	/**
+	 * Start a trail for Effect, attached to AttachTo (or placed at Location when null).
+	 * Returns null when Effect is null.
+	 */
+	UFXSystemComponent* Acquire(UFXSystemAsset* Effect, USceneComponent* AttachTo, const FVector& Location);
+
+	/** Detach a trail, let it fade and reuse it once its particles are gone */
+	void Release(UFXSystemComponent* Trail);
+
+private:
+	/** Fading trails are reclaimed after this long even if the system never reports completion */
+	static constexpr float MaxFadeSeconds = 5.0f;
+
+	/** Owner of every pooled trail component */
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> PoolActor;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UFXSystemComponent>> FreeTrails;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UFXSystemComponent>> ActiveTrails;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UFXSystemComponent>> FadingTrails;
+
+	/** Release time per fading trail, indexed with FadingTrails */
+	TArray<double> FadeStartTimes;
+
+	/** Trail components created since the level started */
+	int32 NumCreated = 0;
+
+	UFXSystemComponent* CreateTrail(UFXSystemAsset* Effect);
+	static bool HasFinished(UFXSystemComponent* Trail);
+
+	void UpdateStats() const;
+};
@@ -1,15 +1,17 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UFOAI.h"
-#include "FighterPawn.h"
+#include "EnemyMovementSubsystem.h"
+#include "EnemyRegistrySubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SceneComponent.h"
 #include "Components/BoxComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
 
 AUFOAI::AUFOAI()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Movement is stepped in bulk by UEnemyMovementSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Create explosion component for death effects
 	ExplosionComp = CreateDefaultSubobject<UExplosionComponent>(TEXT("ExplosionComp"));
@@ -23,8 +25,9 @@ AUFOAI::AUFOAI()
 	CollisionBox = CreateDefaultSubobject<UBoxComponent>(TEXT("CollisionBox"));
 	CollisionBox->SetupAttachment(SceneRoot);
 	CollisionBox->SetBoxExtent(FVector(150.0f, 150.0f, 75.0f));
-	CollisionBox->SetCollisionProfileName(TEXT("BlockAllDynamic"));
-	CollisionBox->SetGenerateOverlapEvents(true);
+	// Enemy profile: blocks projectiles, ignores other enemies, and moves without overlap updates
+	CollisionBox->SetCollisionProfileName(TEXT("Enemy"));
+	CollisionBox->SetGenerateOverlapEvents(false);
 	CollisionBox->SetSimulatePhysics(false);
 	CollisionBox->SetRelativeLocation(FVector(0.0f, 0.0f, 0.0f));
 
@@ -47,11 +50,7 @@ void AUFOAI::BeginPlay()
 		SceneRoot->SetMobility(EComponentMobility::Movable);
 	}
 
-	// Calculate initial distance to base from spawn position
-	FVector SpawnPos = GetActorLocation();
-	CurrentDistanceToBase = FVector::Dist2D(SpawnPos, TargetLocation);
-
-	UE_LOG(LogTemp, Log, TEXT("UFOAI: BeginPlay - Location=%s, DistToBase=%.0f"), *SpawnPos.ToString(), CurrentDistanceToBase);
+	UE_LOG(LogTemp, Log, TEXT("UFOAI: BeginPlay - Location=%s"), *GetActorLocation().ToString());
 
 	// Apply the rotation offset and scale to the mesh (visual only)
 	if (UFOMesh)
@@ -65,10 +64,28 @@ void AUFOAI::BeginPlay()
 		UE_LOG(LogTemp, Log, TEXT("UFOAI: Applied mesh scale %s"), *MeshScale.ToString());
 	}
 
-	// Pick initial waypoint
-	if (bTargetSet)
+	// Register with the movement subsystem using the current configuration
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		FEnemyMotionParams Params;
+		Params.TargetLocation = TargetLocation;
+		Params.RotationSpeed = RotationSpeed;
+		Params.FlyHeight = FlyHeight;
+		Params.RateOfFire = RateOfFire;
+		Params.MinApproachIncrement = MinApproachIncrement;
+		Params.MaxApproachIncrement = MaxApproachIncrement;
+		Params.MinLateralSpread = MinLateralSpread;
+		Params.MaxLateralSpread = MaxLateralSpread;
+		Params.MinHoverTime = MinHoverTime;
+		Params.MaxHoverTime = MaxHoverTime;
+		Params.LineOfFireDistance = LineOfFireDistance;
+
+		MovementHandle = Movement->RegisterEnemy(this, EEnemyType::UFO, Params, MoveSpeed);
+	}
+
+	if (UEnemyRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UEnemyRegistrySubsystem>())
 	{
-		PickNewWaypoint();
+		Registry->RegisterEnemy(this, EEnemyType::UFO);
 	}
 }
 
@@ -81,88 +98,47 @@ void AUFOAI::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		ExplosionComp->SpawnExplosionAtOwner();
 	}
 
-	Super::EndPlay(EndPlayReason);
-}
-
-void AUFOAI::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	// Don't update AI when game is paused
-	if (IsGamePaused())
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
 	{
-		return;
+		Movement->UnregisterEnemy(MovementHandle);
 	}
 
-	if (!bTargetSet)
+	if (UEnemyRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UEnemyRegistrySubsystem>())
 	{
-		return;
+		Registry->UnregisterEnemy(this);
 	}
 
-	if (bIsHovering)
-	{
-		// Hovering at waypoint - count down timer
-		HoverTimer -= DeltaTime;
-		if (HoverTimer <= 0.0f)
-		{
-			bIsHovering = false;
-			PickNewWaypoint();
-			UE_LOG(LogTemp, Log, TEXT("UFOAI: Hover complete, moving to new waypoint %s"), *CurrentWaypoint.ToString());
-		}
-	}
-	else
-	{
-		// Flying toward waypoint
-		MoveTowardWaypoint(DeltaTime);
-		RotateTowardWaypoint(DeltaTime);
-
-		// Check if we reached the waypoint
-		float DistToWaypoint = FVector::Dist(GetActorLocation(), CurrentWaypoint);
-		if (DistToWaypoint <= WaypointReachedThreshold)
-		{
-			bIsHovering = true;
-			HoverTimer = FMath::FRandRange(MinHoverTime, MaxHoverTime);
-			UE_LOG(LogTemp, Log, TEXT("UFOAI: Reached waypoint, hovering for %.1f seconds"), HoverTimer);
-		}
-	}
-
-	// Fire at base only when at stopping distance (line of fire)
-	if (bReachedLineOfFire && !bIsFiring)
-	{
-		bIsFiring = true;
-		FireTimer = RateOfFire;
-		UE_LOG(LogTemp, Log, TEXT("UFOAI: Reached line of fire! Starting to fire at base."));
-	}
+	Super::EndPlay(EndPlayReason);
+}
 
-	if (bIsFiring)
-	{
-		FireTimer -= DeltaTime;
-		if (FireTimer <= 0.0f)
-		{
-			FireAtBase();
-			FireTimer = RateOfFire;
-		}
-	}
+UEnemyMovementSubsystem* AUFOAI::GetMovementSubsystem() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UEnemyMovementSubsystem>() : nullptr;
 }
 
 void AUFOAI::SetTargetLocation(const FVector& NewTarget)
 {
 	TargetLocation = NewTarget;
-	bTargetSet = true;
 
-	// Recalculate distance to base now that we have the correct target
-	CurrentDistanceToBase = FVector::Dist2D(GetActorLocation(), TargetLocation);
-
-	UE_LOG(LogTemp, Log, TEXT("UFOAI: Target set to %s, CurrentPos=%s, DistToBase=%.0f"), 
-		*TargetLocation.ToString(), *GetActorLocation().ToString(), CurrentDistanceToBase);
+	// Picks the first waypoint now that we know where the base is
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		Movement->SetTargetLocation(MovementHandle, TargetLocation);
+	}
 
-	// Pick first waypoint now that we know where the base is
-	PickNewWaypoint();
+	UE_LOG(LogTemp, Log, TEXT("UFOAI: Target set to %s, CurrentPos=%s"), 
+		*TargetLocation.ToString(), *GetActorLocation().ToString());
 }
 
 void AUFOAI::SetMoveSpeed(float NewSpeed)
 {
 	MoveSpeed = FMath::Max(0.0f, NewSpeed);
+
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		Movement->SetMoveSpeed(MovementHandle, MoveSpeed);
+	}
 }
 
 void AUFOAI::SetMeshRotation(float YawRotation)
@@ -194,11 +170,28 @@ void AUFOAI::SetFlyHeight(float NewHeight)
 	FVector CurrentLocation = GetActorLocation();
 	CurrentLocation.Z = FlyHeight;
 	SetActorLocation(CurrentLocation);
+
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		if (FEnemyMotionParams* Params = Movement->GetParams(MovementHandle))
+		{
+			Params->FlyHeight = FlyHeight;
+		}
+		Movement->SyncFromActor(MovementHandle);
+	}
 }
 
 void AUFOAI::SetRateOfFire(float Rate)
 {
 	RateOfFire = FMath::Max(0.1f, Rate);
+
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
+	{
+		if (FEnemyMotionParams* Params = Movement->GetParams(MovementHandle))
+		{
+			Params->RateOfFire = RateOfFire;
+		}
+	}
 }
 
 void AUFOAI::SetApproachSettings(float InMinApproachIncrement, float InMaxApproachIncrement, float InMinLateralSpread, float InMaxLateralSpread, float InMinHoverTime, float InMaxHoverTime, float InLineOfFireDistance)
@@ -210,110 +203,18 @@ void AUFOAI::SetApproachSettings(float InMinApproachIncrement, float InMaxApproa
 	MinHoverTime = InMinHoverTime;
 	MaxHoverTime = InMaxHoverTime;
 	LineOfFireDistance = InLineOfFireDistance;
-}
-
-void AUFOAI::PickNewWaypoint()
-{
-	// If already at stopping distance, stay there (pick nearby hover points)
-	if (bReachedLineOfFire)
-	{
-		// Hover around the stopping distance with some lateral variation
-		float RandomAngle = FMath::FRandRange(0.0f, 360.0f);
-		float AngleRad = FMath::DegreesToRadians(RandomAngle);
-		float Radius = LineOfFireDistance + FMath::FRandRange(-100.0f, 100.0f);
-		Radius = FMath::Max(Radius, 50.0f);
-
-		CurrentWaypoint = FVector(
-			TargetLocation.X + FMath::Cos(AngleRad) * Radius,
-			TargetLocation.Y + FMath::Sin(AngleRad) * Radius,
-			FlyHeight);
-
-		UE_LOG(LogTemp, Log, TEXT("UFOAI: Hovering near base, waypoint at %s (radius=%.0f)"), *CurrentWaypoint.ToString(), Radius);
-		return;
-	}
-
-	// Decrease distance to base by a random increment
-	float ApproachAmount = FMath::FRandRange(MinApproachIncrement, MaxApproachIncrement);
-	CurrentDistanceToBase = FMath::Max(CurrentDistanceToBase - ApproachAmount, LineOfFireDistance);
-
-	// Check if we've reached the stopping distance
-	if (CurrentDistanceToBase <= LineOfFireDistance)
-	{
-		bReachedLineOfFire = true;
-		CurrentDistanceToBase = LineOfFireDistance;
-		UE_LOG(LogTemp, Log, TEXT("UFOAI: Reached stopping distance (%.0f)"), LineOfFireDistance);
-	}
-
-	// Pick a random angle from the base, then apply lateral spread
-	// Direction from base to current position
-	FVector CurrentPos = GetActorLocation();
-	FVector ToUFO = CurrentPos - TargetLocation;
-	ToUFO.Z = 0.0f;
-	float CurrentAngle = FMath::Atan2(ToUFO.Y, ToUFO.X);
-
-	// Add random lateral offset angle based on spread
-	float LateralOffset = FMath::FRandRange(MinLateralSpread, MaxLateralSpread);
-	if (FMath::RandBool()) LateralOffset = -LateralOffset;
-	float LateralAngleOffset = FMath::Atan2(LateralOffset, CurrentDistanceToBase);
-	float NewAngle = CurrentAngle + LateralAngleOffset;
-
-	float X = TargetLocation.X + FMath::Cos(NewAngle) * CurrentDistanceToBase;
-	float Y = TargetLocation.Y + FMath::Sin(NewAngle) * CurrentDistanceToBase;
-
-	CurrentWaypoint = FVector(X, Y, FlyHeight);
-
-	UE_LOG(LogTemp, Log, TEXT("UFOAI: New waypoint at %s (distToBase=%.0f, lateralOffset=%.0f)"), *CurrentWaypoint.ToString(), CurrentDistanceToBase, LateralOffset);
-}
-
-void AUFOAI::MoveTowardWaypoint(float DeltaTime)
-{
-	FVector CurrentLocation = GetActorLocation();
-	FVector Direction = (CurrentWaypoint - CurrentLocation).GetSafeNormal();
-
-	FVector NewLocation = CurrentLocation + Direction * MoveSpeed * DeltaTime;
-	NewLocation.Z = FlyHeight; // Maintain fly height
-
-	SetActorLocation(NewLocation);
-}
-
-void AUFOAI::RotateTowardWaypoint(float DeltaTime)
-{
-	FVector CurrentLocation = GetActorLocation();
-	FVector Direction = (CurrentWaypoint - CurrentLocation).GetSafeNormal();
-	Direction.Z = 0.0f;
-
-	if (Direction.IsNearlyZero())
-	{
-		return;
-	}
-
-	FRotator TargetRotation = Direction.Rotation();
-	FRotator CurrentRotation = GetActorRotation();
-
-	float NewYaw = FMath::FInterpTo(CurrentRotation.Yaw, TargetRotation.Yaw, DeltaTime, RotationSpeed);
-	SetActorRotation(FRotator(0.0f, NewYaw, 0.0f));
-}
-
-void AUFOAI::FireAtBase()
-{
-	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
-	if (AFighterPawn* Fighter = Cast<AFighterPawn>(PlayerPawn))
-	{
-		Fighter->DamageBase(1);
-	}
-}
 
-bool AUFOAI::IsGamePaused() const
-{
-	if (UWorld* World = GetWorld())
+	if (UEnemyMovementSubsystem* Movement = GetMovementSubsystem())
 	{
-		if (APlayerController* PC = World->GetFirstPlayerController())
+		if (FEnemyMotionParams* Params = Movement->GetParams(MovementHandle))
 		{
-			if (AFighterPawn* Fighter = Cast<AFighterPawn>(PC->GetPawn()))
-			{
-				return Fighter->GetGameState() == EGameState::Paused;
-			}
+			Params->MinApproachIncrement = MinApproachIncrement;
+			Params->MaxApproachIncrement = MaxApproachIncrement;
+			Params->MinLateralSpread = MinLateralSpread;
+			Params->MaxLateralSpread = MaxLateralSpread;
+			Params->MinHoverTime = MinHoverTime;
+			Params->MaxHoverTime = MaxHoverTime;
+			Params->LineOfFireDistance = LineOfFireDistance;
 		}
 	}
-	return false;
 }
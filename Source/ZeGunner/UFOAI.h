@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 #include "ExplosionComponent.h"
-#include "FighterPawn.h"
+#include "EnemyTypes.h"
 #include "UFOAI.generated.h"
 
+class UEnemyMovementSubsystem;
+
 UCLASS()
 class ZEGUNNER_API AUFOAI : public APawn
 {
@@ -22,7 +24,6 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** The static mesh component for the UFO */
@@ -93,32 +94,10 @@ public:
 	float GetMoveSpeed() const { return MoveSpeed; }
 
 private:
-	/** Has a target been explicitly set? */
-	bool bTargetSet = false;
-
-	/** Whether the UFO is currently hovering at a waypoint */
-	bool bIsHovering = false;
-
-	/** Whether the UFO has reached its current waypoint */
-	bool bReachedWaypoint = false;
-
-	/** Whether this UFO is firing at the base */
-	bool bIsFiring = false;
-
 	/** Seconds between shots at the base */
 	float RateOfFire = 3.0f;
 
-	/** Timer counting down to next shot */
-	float FireTimer = 0.0f;
-
-	/** Current waypoint the UFO is flying toward */
-	FVector CurrentWaypoint;
-
-	/** Timer for hovering at waypoint */
-	float HoverTimer = 0.0f;
-
-	/** Current distance from the base (decreases each waypoint) */
-	float CurrentDistanceToBase = 0.0f;
+	// ==================== Approach Settings ====================
 
 	/** Minimum distance to get closer to base per waypoint (units) */
 	float MinApproachIncrement = 200.0f;
@@ -135,30 +114,15 @@ private:
 	/** Distance from base where UFO stops approaching and starts firing (line of fire) */
 	float LineOfFireDistance = 500.0f;
 
-	/** Whether the UFO has reached its line of fire */
-	bool bReachedLineOfFire = false;
-
 	/** Minimum time to hover at a waypoint (seconds) */
 	float MinHoverTime = 1.0f;
 
 	/** Maximum time to hover at a waypoint (seconds) */
 	float MaxHoverTime = 3.0f;
 
-	/** Distance threshold to consider waypoint reached */
-	float WaypointReachedThreshold = 50.0f;
-
-	/** Pick a new random waypoint near the base */
-	void PickNewWaypoint();
-
-	/** Move toward the current waypoint */
-	void MoveTowardWaypoint(float DeltaTime);
-
-	/** Smoothly rotate toward the current waypoint */
-	void RotateTowardWaypoint(float DeltaTime);
-
-	/** Fire at the base (damage it) */
-	void FireAtBase();
+	/** Slot in the enemy movement subsystem (movement state lives there) */
+	FEnemyHandle MovementHandle;
 
-	/** Check if the game is currently paused */
-	bool IsGamePaused() const;
+	/** Get the movement subsystem for this world */
+	UEnemyMovementSubsystem* GetMovementSubsystem() const;
 };
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WeaponAudioSubsystem.h"
+#include "ZeGunner.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon Voices"), STAT_WeaponVoices, STATGROUP_ZeGunner);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Weapon Voices Stolen"), STAT_WeaponVoicesStolen, STATGROUP_ZeGunner);
+
+static TAutoConsoleVariable<int32> CVarMaxWeaponVoices(
+	TEXT("ZeGunner.Audio.MaxWeaponVoices"),
+	6,
+	TEXT("Most weapon fire sounds playing at once; a new shot past the cap steals the oldest voice."),
+	ECVF_Default);
+
+bool UWeaponAudioSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ==================== Voices ====================
+
+void UWeaponAudioSubsystem::PlayWeaponSound(USoundBase* Sound, const FVector& Location)
+{
+	if (!Sound || Volume <= 0.0f)
+	{
+		return;
+	}
+
+	const int32 Index = PickVoice();
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	UAudioComponent* Voice = Voices[Index];
+	if (Voice->IsPlaying())
+	{
+		Voice->Stop();
+		INC_DWORD_STAT(STAT_WeaponVoicesStolen);
+	}
+
+	Voice->SetWorldLocation(Location);
+	Voice->SetSound(Sound);
+	Voice->SetVolumeMultiplier(Volume);
+	Voice->Play();
+	VoiceStartTimes[Index] = GetWorld()->GetTimeSeconds();
+
+	SET_DWORD_STAT(STAT_WeaponVoices, Voices.Num());
+}
+
+int32 UWeaponAudioSubsystem::PickVoice()
+{
+	int32 Oldest = INDEX_NONE;
+	for (int32 Index = 0; Index < Voices.Num(); ++Index)
+	{
+		if (!IsValid(Voices[Index]))
+		{
+			continue;
+		}
+		if (!Voices[Index]->IsPlaying())
+		{
+			return Index;
+		}
+		if (Oldest == INDEX_NONE || VoiceStartTimes[Index] < VoiceStartTimes[Oldest])
+		{
+			Oldest = Index;
+		}
+	}
+
+	if (Voices.Num() < FMath::Max(1, CVarMaxWeaponVoices.GetValueOnGameThread()))
+	{
+		if (UAudioComponent* Voice = CreateVoice())
+		{
+			VoiceStartTimes.Add(0.0);
+			return Voices.Add(Voice);
+		}
+	}
+
+	return Oldest;
+}
+
+UAudioComponent* UWeaponAudioSubsystem::CreateVoice()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	if (!VoiceOwner)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		VoiceOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!VoiceOwner)
+		{
+			return nullptr;
+		}
+	}
+
+	UAudioComponent* Voice = NewObject<UAudioComponent>(VoiceOwner);
+	Voice->bAutoActivate = false;
+	Voice->bAutoDestroy = false;
+	Voice->bStopWhenOwnerDestroyed = true;
+	Voice->RegisterComponent();
+	return Voice;
+}
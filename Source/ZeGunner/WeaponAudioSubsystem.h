@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponAudioSubsystem.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+/**
+ * Small rotating pool of audio components for weapon fire. At most
+ * ZeGunner.Audio.MaxWeaponVoices sounds play at once; when every voice is busy the oldest one
+ * is stopped and reused, so sustained fire neither allocates nor piles up active sounds.
+ * Also caches the player's volume setting so sound code doesn't have to look up the pawn.
+ */
+UCLASS()
+class ZEGUNNER_API UWeaponAudioSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Play a weapon sound at Location on a pooled voice (stealing the oldest when all are busy) */
+	void PlayWeaponSound(USoundBase* Sound, const FVector& Location);
+
+	/** Cached player volume (0-1), applied to weapon voices and read by other sound code */
+	float GetVolume() const { return Volume; }
+
+	/** Update the cached volume; call whenever the player changes it */
+	void SetVolume(float InVolume) { Volume = FMath::Clamp(InVolume, 0.0f, 1.0f); }
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> VoiceOwner;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAudioComponent>> Voices;
+
+	/** World time each voice last started, indexed with Voices */
+	TArray<double> VoiceStartTimes;
+
+	float Volume = 1.0f;
+
+	/** Idle voice, a new one while under the cap, or the oldest playing one */
+	int32 PickVoice();
+
+	UAudioComponent* CreateVoice();
+};
@@ -3,4 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
+/** Stat group for gameplay systems (use "stat ZeGunner" in the console) */
+DECLARE_STATS_GROUP(TEXT("ZeGunner"), STATGROUP_ZeGunner, STATCAT_Advanced);